@@ -148,6 +148,8 @@ extern "C" {
 #define MAX_DTOE_IRN    7200.0                  // Maximum ephemeris age tolerance: IRN
 #define MAX_DTOE_SBS    360.0                   // Maximum ephemeris age tolerance: SBS
 
+#define NEPHSRC         2                       // Number of ephemeris sources (0: default or GAL I/NAV, 1: GAL F/NAV)
+
 #define OMGE_GPS        7.2921151467E-5         // Earth's angular velocity (GPS)
 #define OMGE_GLO        7.2921150000E-5         // Earth's angular velocity (GLO)
 #define OMGE_GAL        7.2921151467E-5         // Earth's angular velocity (GAL)
@@ -0,0 +1,121 @@
+// =============================================================================
+// Decompression function header
+//
+// -----------------------------------------------------------------------------
+// Yongrae Jo, 0727ggame@sju.ac.kr
+// =============================================================================
+
+#ifndef DECOMP_H
+#define DECOMP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Standard library
+#include <stddef.h>         // for size_t
+
+// GNSS library
+#include "types.h"          // for buffer_t
+
+// =============================================================================
+// Type definitions
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// Decompression stream (opaque, see OpenDecomp)
+// -----------------------------------------------------------------------------
+typedef struct decomp decomp_t;
+
+// =============================================================================
+// Decompression functions
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// Open file for decompressed reading
+//
+// The format is detected from the file contents: gzip (.gz), UNIX compress
+// (.Z) or plain bytes, each of which may hold compact RINEX (Hatanaka CRINEX
+// 1.0/3.0). Compact RINEX is restored to RINEX 2/3 text. Other files are read
+// as they are.
+//
+// args:
+//  const char      *filename (I) : file name
+//
+// return:
+//        decomp_t  *dec      (O) : decompression stream (NULL if error)
+// -----------------------------------------------------------------------------
+decomp_t *OpenDecomp(const char *filename);
+
+// -----------------------------------------------------------------------------
+// Read decompressed data
+//
+// Same as fread: fewer bytes than size are returned only at the end of data or
+// on error (see ErrorDecomp).
+//
+// args:
+//        decomp_t  *dec    (I,O) : decompression stream
+//        void      *buff   (O)   : data buffer
+//        size_t    size    (I)   : number of bytes to read
+//
+// return:
+//        size_t    n       (O)   : number of bytes read
+// -----------------------------------------------------------------------------
+size_t ReadDecomp(decomp_t *dec, void *buff, size_t size);
+
+// -----------------------------------------------------------------------------
+// Check decompression error
+//
+// args:
+//  const decomp_t  *dec    (I) : decompression stream
+//
+// return:
+//        int       info    (O) : 1 if read or format error, 0 if not
+// -----------------------------------------------------------------------------
+int ErrorDecomp(const decomp_t *dec);
+
+// -----------------------------------------------------------------------------
+// Resume reading after end of data
+//
+// Clears the end of data of a plain (not compressed) file, so that data
+// appended to the file afterwards can be read by ReadDecomp.
+//
+// args:
+//        decomp_t  *dec    (I,O) : decompression stream
+//
+// return:
+//        int       info    (O)   : 1 if resumed, 0 if compressed file or error
+// -----------------------------------------------------------------------------
+int ResumeDecomp(decomp_t *dec);
+
+// -----------------------------------------------------------------------------
+// Close decompression stream
+//
+// args:
+//        decomp_t  *dec    (I) : decompression stream
+//
+// return:
+//        void              (-) : no return value
+// -----------------------------------------------------------------------------
+void CloseDecomp(decomp_t *dec);
+
+// -----------------------------------------------------------------------------
+// Decompress file buffer in memory
+//
+// If the buffer holds gzip, UNIX compress or compact RINEX data, it is
+// replaced by the decompressed text in heap memory (buffer->map = 0).
+// Other data are left as they are. Lines must be indexed afterwards.
+//
+// args:
+//        buffer_t  *buffer (I,O) : buffer structure (lines not indexed)
+//
+// return:
+//        int       info    (O)   : 1 if successful or not compressed, 0 if failed
+// -----------------------------------------------------------------------------
+int DecompBuff(buffer_t *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -46,10 +46,28 @@ void FreeEphs(ephs_t *ephs);
 // -----------------------------------------------------------------------------
 int AddEph(ephs_t *ephs, const eph_t *eph);
 
+// -----------------------------------------------------------------------------
+// Reserve memory of ephemeris data set structure
+//
+// Allocates memory for at least n ephemeris data in one step (not shrunk if
+// n <= ephs->nmax).
+//
+// args:
+//        ephs_t *ephs (I,O) : ephemeris data set structure
+//        int    n     (I)   : number of ephemeris data to reserve
+//
+// return:
+//        int    info  (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int ReserveEphs(ephs_t *ephs, int n);
+
 // -----------------------------------------------------------------------------
 // Sort ephemeris data set by the order of satellite index and time transmission
 // (eph.ttr)
 //
+// Duplicated ephemeris data are removed and the time index is rebuilt (see
+// IndexEphs).
+//
 // args:
 //        ephs_t *ephs (I,O) : ephemeris data set structure
 //
@@ -58,10 +76,52 @@ int AddEph(ephs_t *ephs, const eph_t *eph);
 // -----------------------------------------------------------------------------
 void SortEphs(ephs_t *ephs);
 
+// -----------------------------------------------------------------------------
+// Build time index of ephemeris data set
+//
+// Index keys of each ephemeris source (default or GAL I/NAV, GAL F/NAV) are
+// sorted by time transmission (eph.ttr), so that SelectEph finds ephemeris data
+// by binary search. The index is outdated by AddEph, and SelectEph falls back
+// to linear search until it is rebuilt. The index stamp is changed, so that
+// the ephemeris selection caches of the data set are outdated.
+//
+// args:
+//        ephs_t *ephs (I,O) : ephemeris data set structure
+//
+// return:
+//        int    info  (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int IndexEphs(ephs_t *ephs);
+
 // =============================================================================
 // Broadcast ephemeris functions
 // =============================================================================
 
+// -----------------------------------------------------------------------------
+// Get satellite velocity and clock drift type of SatPosClkBrdc (default: 0)
+//
+// 0 - analytic (Keplerian element rates, GLONASS integrated velocity)
+// 1 - central difference of position and clock bias (+-1 ms, for validation)
+//
+// args:
+//        void         (-) : no input arguments
+//
+// return:
+//        int   type   (O) : satellite velocity and clock drift type
+// -----------------------------------------------------------------------------
+int GetVelType(void);
+
+// -----------------------------------------------------------------------------
+// Set satellite velocity and clock drift type of SatPosClkBrdc
+//
+// 0 - analytic (Keplerian element rates, GLONASS integrated velocity)
+// 1 - central difference of position and clock bias (+-1 ms, for validation)
+//
+// args:
+//        int   type   (I) : satellite velocity and clock drift type
+// -----------------------------------------------------------------------------
+void SetVelType(int type);
+
 // -----------------------------------------------------------------------------
 // Get broadcast ephemeris type (default: 0)
 //
@@ -169,10 +229,51 @@ int TestEph(const eph_t *eph);
 // -----------------------------------------------------------------------------
 eph_t *SelectEph(double ephtime, int sat, const nav_t *nav, int iode);
 
+// -----------------------------------------------------------------------------
+// Initialize ephemeris selection cache
+//
+// The cache must be initialized before its first use and again when the
+// navigation data it is used with is initialized (InitNav).
+//
+// args:
+//        ephSel_t *sel (O) : ephemeris selection cache
+//
+// return:
+//        void          (-) : no return value
+// -----------------------------------------------------------------------------
+void InitEphSel(ephSel_t *sel);
+
+// -----------------------------------------------------------------------------
+// Select broadcast ephemeris data with ephemeris selection cache
+//
+// Same selection as SelectEph. If the ephemeris data set of the satellite is
+// indexed (see IndexEphs), the last selection per satellite and ephemeris
+// source is kept in sel with its validity interval and returned while ephtime
+// stays inside it. A cache entry is outdated when the index of the data set is
+// rebuilt (SortEphs, IndexEphs) or freed. The navigation data is not modified,
+// so threads sharing one nav can each use their own sel.
+//
+// args:
+//        double   ephtime (I)   : ephemeris time (GPST) [s]
+//        int      sat     (I)   : satellite index
+//  const nav_t    *nav    (I)   : navigation data
+//        int      iode    (I)   : IODE or IODnav (G,R,E,C,J,I)
+//                               : (R: 0-6 bit of tb field) (C: BDS GBAS algorithm)
+//                               : (-1: no consider IODE for selection)
+//        ephSel_t *sel    (I,O) : ephemeris selection cache (NULL: no cache)
+//
+// return:
+//        eph_t    *eph    (O)   : selected ephemeris data (if error, return NULL)
+// -----------------------------------------------------------------------------
+eph_t *SelectEphSel(double ephtime, int sat, const nav_t *nav, int iode, ephSel_t *sel);
+
 // -----------------------------------------------------------------------------
 // Compute satellite position, velocity, and clock bias/drift using broadcast
 // ephemeris data
 //
+// Velocity and clock drift are analytic, or central differences if set by
+// SetVelType.
+//
 // args:
 //        double  ephtime (I) : ephemeris time (GPST) [s]
 //        double  time    (I) : satellite emission time (GPST) [s]
@@ -192,6 +293,56 @@ eph_t *SelectEph(double ephtime, int sat, const nav_t *nav, int iode);
 int SatPosClkBrdc(double ephtime, double time, int sat, const nav_t *nav,
 int iode, mat_t *rs, mat_t *dts, double *var, eph_t *eph);
 
+// -----------------------------------------------------------------------------
+// Compute satellite position, velocity, and clock bias/drift using broadcast
+// ephemeris data with ephemeris selection cache
+//
+// Same as SatPosClkBrdc, with the ephemeris data selected by SelectEphSel.
+//
+// args:
+//        double   ephtime (I)   : ephemeris time (GPST) [s]
+//        double   time    (I)   : satellite emission time (GPST) [s]
+//        int      sat     (I)   : satellite index
+//  const nav_t    *nav    (I)   : navigation data
+//        int      iode    (I)   : IODE or IODnav (-1: no consider IODE for selection)
+//        ephSel_t *sel    (I,O) : ephemeris selection cache (NULL: no cache)
+//        mat_t    *rs     (O)   : (optional) satellite position/velocity (ECEF) (1x6) [m,m/s]
+//        mat_t    *dts    (O)   : (optional) satellite clock bias/drift (1x2) [s,s/s]
+//        double   *var    (O)   : (optional) variance of position and clock bias [m^2]
+//        eph_t    *eph    (O)   : (optional) used broadcast ephemeris data
+//
+// return:
+//        int      flag    (O)   : test result (1:ok, 0:error)
+// -----------------------------------------------------------------------------
+int SatPosClkBrdcSel(double ephtime, double time, int sat, const nav_t *nav,
+int iode, ephSel_t *sel, mat_t *rs, mat_t *dts, double *var, eph_t *eph);
+
+// -----------------------------------------------------------------------------
+// Compute satellite positions, velocities, and clock biases/drifts of multiple
+// satellites using broadcast ephemeris data
+//
+// Same results as SatPosClkBrdc for each satellite. With analytic velocity
+// (SetVelType) and AVX2 support, Keplerian satellites (not BeiDou GEO) are
+// computed 4 at a time by SIMD lanes (differences to SatPosClkBrdc below 1E-6 m).
+// The other satellites are computed one by one.
+//
+// args:
+//        int          n       (I)   : number of satellites
+//  const double       *ephtime(I)   : (optional) ephemeris times (GPST) (n) [s]
+//                                   : (NULL: emission times)
+//  const double       *time   (I)   : satellite emission times (GPST) (n) [s]
+//  const int          *sat    (I)   : satellite indexes (n)
+//  const int          *iode   (I)   : (optional) IODE or IODnav (n) (NULL: -1 for all)
+//  const nav_t        *nav    (I)   : navigation data
+//        ephSel_t     *sel    (I,O) : ephemeris selection cache (NULL: no cache)
+//        satPosClks_t *out    (O)   : satellite positions, velocities and clocks (n)
+//
+// return:
+//        int          nok     (O)   : number of satellites computed (see out->stat)
+// -----------------------------------------------------------------------------
+int SatPosClkBrdcBatch(int n, const double *ephtime, const double *time, const int *sat,
+                       const int *iode, const nav_t *nav, ephSel_t *sel, satPosClks_t *out);
+
 
 // =============================================================================
 // End of header
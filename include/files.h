@@ -113,6 +113,10 @@ int InitBuff(buffer_t *buffer);
 // -----------------------------------------------------------------------------
 // Get file buffer from file
 //
+// The file is memory-mapped read-only where supported (buffer->map = 1) and
+// read into heap memory otherwise. Lines are indexed without modifying the
+// data: a trailing '\r' (CR/LF) is excluded from the line length.
+//
 // args:
 //  const char      *filename (I)   : file name
 //        buffer_t  *buffer   (O)   : buffer structure
@@ -122,6 +126,20 @@ int InitBuff(buffer_t *buffer);
 // -----------------------------------------------------------------------------
 int GetBuff(const char *filename, buffer_t *buffer);
 
+// -----------------------------------------------------------------------------
+// Index lines of buffer data
+//
+// Rebuilds the line table of buffer->buff[0, size) (e.g. for a chunk read by
+// the caller into a heap buffer). The previous line table is freed.
+//
+// args:
+//        buffer_t  *buffer   (I,O) : buffer structure
+//
+// return:
+//        int       info      (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int IndexBuff(buffer_t *buffer);
+
 // -----------------------------------------------------------------------------
 // Free file buffer structure
 //
@@ -140,6 +158,10 @@ void FreeBuff(buffer_t *buffer);
 // -----------------------------------------------------------------------------
 // Read observation data files (RINEX OBS, RTCM (TBD), UBX (TBD))
 //
+// If nav->opt->obscache is set, a fresh observation cache of a file is loaded
+// instead of parsing the file (see ReadObsCache); otherwise the file is parsed
+// and its cache is written next to it. No cache is used by default.
+//
 // args:
 //       files_t *files (I)   : file string data structure
 //       nav_t   *nav   (I,O) : navigation data structure
@@ -162,6 +184,42 @@ void ReadObsFiles(files_t *files, nav_t *nav, obss_t *obs);
 // -----------------------------------------------------------------------------
 void ReadNavFiles(files_t *files, nav_t *nav);
 
+// -----------------------------------------------------------------------------
+// Read observation data files in parallel
+//
+// Files are read on a pool of nthread threads into private containers and
+// merged in file order, so receiver indices and the result are the same as
+// ReadObsFiles. Falls back to ReadObsFiles if nthread <= 1 or on Windows.
+//
+// args:
+//       files_t *files   (I)   : file string data structure
+//       nav_t   *nav     (I,O) : navigation data structure
+//       obss_t  *obs     (I,O) : observation data structure
+//       int     nthread  (I)   : number of threads
+//
+// return:
+//       void             (-)   : no return value
+// -----------------------------------------------------------------------------
+void ReadObsFilesPar(files_t *files, nav_t *nav, obss_t *obs, int nthread);
+
+// -----------------------------------------------------------------------------
+// Read navigation data files in parallel
+//
+// Files are read on a pool of nthread threads into private navigation data,
+// then ephemerides are merged per satellite in file order and sorted. The
+// result is the same as ReadNavFiles. Falls back to ReadNavFiles if
+// nthread <= 1 or on Windows.
+//
+// args:
+//       files_t *files   (I)   : file string data structure
+//       nav_t   *nav     (I,O) : navigation data structure
+//       int     nthread  (I)   : number of threads
+//
+// return:
+//       void             (-)   : no return value
+// -----------------------------------------------------------------------------
+void ReadNavFilesPar(files_t *files, nav_t *nav, int nthread);
+
 // -----------------------------------------------------------------------------
 // Read DCB data files
 //
@@ -199,6 +257,94 @@ void ReadAtxFiles(files_t *files, nav_t *nav);
 // -----------------------------------------------------------------------------
 void ReadFiles(file_t *file, nav_t *nav, obss_t *obs);
 
+// =============================================================================
+// Observation cache functions
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// Read observation cache file of source file
+//
+// Loads the binary snapshot "<filename>.obc" of the observation data and the
+// station information of a source file written by WriteObsCache. The cache is
+// used only if it is fresh: the header stamp must match the size and
+// modification time of the source file, the record layout, and the read filter
+// of nav->opt. The file is memory-mapped read-only where supported and the
+// records are copied to observation data in one block.
+//
+// args:
+//        nav_t   *nav      (I,O) : navigation data (station information)
+//        obss_t  *obs      (I,O) : observation data
+//        int     rcvidx    (I)   : receiver index (1:rover, 2:base, ...)
+//  const char    *filename (I)   : source file name
+//
+// return:
+//        int     info      (O)   : 1 if successful, 0 if missing or stale
+// -----------------------------------------------------------------------------
+int ReadObsCache(nav_t *nav, obss_t *obs, int rcvidx, const char *filename);
+
+// -----------------------------------------------------------------------------
+// Write observation cache file of source file
+//
+// Writes the observation data of the receiver and its station information to
+// "<filename>.obc": a little-endian header (magic, version, record size, stamp,
+// number of records, station information) padded to 64 bytes, followed by the
+// obs_t records. The file is written to a temporary file and renamed.
+//
+// args:
+//  const nav_t   *nav      (I) : navigation data (station information)
+//  const obss_t  *obs      (I) : observation data
+//        int     rcvidx    (I) : receiver index (1:rover, 2:base, ...)
+//  const char    *filename (I) : source file name
+//
+// return:
+//        int     info      (O) : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int WriteObsCache(const nav_t *nav, const obss_t *obs, int rcvidx, const char *filename);
+
+// =============================================================================
+// Navigation cache functions
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// Read navigation cache file of source files
+//
+// Loads the binary snapshot of the arranged, sorted and deduplicated
+// ephemeris data of all satellites, the broadcast ionosphere parameters and
+// the GLONASS FCN table written by WriteNavCache. The cache is used only if it
+// is fresh: the header stamp must match the names, sizes and modification times
+// of the source files in order and the record layout. The file is
+// memory-mapped read-only where supported. The ephemeris data of all
+// satellites and the ionosphere parameters of nav are replaced.
+//
+// args:
+//        nav_t   *nav      (I,O) : navigation data
+//  const files_t *files    (I)   : source navigation file names
+//  const char    *filename (I)   : cache file name
+//
+// return:
+//        int     info      (O)   : 1 if successful, 0 if missing or stale
+// -----------------------------------------------------------------------------
+int ReadNavCache(nav_t *nav, const files_t *files, const char *filename);
+
+// -----------------------------------------------------------------------------
+// Write navigation cache file of source files
+//
+// Writes a little-endian header (magic, version, record size, stamp, number of
+// records per satellite, GLONASS FCN table, ionosphere parameters) padded to
+// 64 bytes, followed by the eph_t records of each satellite in satellite order.
+// The ephemeris data should be sorted (e.g. by ReadNavFiles). The file is
+// written to a temporary file and renamed.
+//
+// args:
+//  const nav_t   *nav      (I) : navigation data
+//  const files_t *files    (I) : source navigation file names
+//  const char    *filename (I) : cache file name
+//
+// return:
+//        int     info      (O) : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int WriteNavCache(const nav_t *nav, const files_t *files, const char *filename);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@ extern "C" {
 #include "obs.h"
 #include "ephemeris.h"
 #include "files.h"
+#include "decomp.h"
 #include "rinex.h"
 #include "option.h"
 #include "solution.h"
@@ -53,10 +53,30 @@ void FreeObss(obss_t *obss);
 // -----------------------------------------------------------------------------
 int AddObs(obss_t *obss, const obs_t *obs);
 
+// -----------------------------------------------------------------------------
+// Reserve memory of observation data set
+//
+// Allocates memory for at least n observation data in one step, so that the
+// following AddObs calls up to n do not reallocate and copy the data. The
+// memory is not shrunk if n <= obss->nmax.
+//
+// args:
+//        obss_t *obss (I,O) : observation data set structure
+//        int    n     (I)   : number of observation data to reserve
+//
+// return:
+//        int    info  (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int ReserveObss(obss_t *obss, int n);
+
 // -----------------------------------------------------------------------------
 // Sort observation data set by the order of time, receiver index, satellite
 // index
 //
+// Compact (time, rcv, sat) keys are sorted by merging ascending runs (e.g. one
+// per appended file), then records are moved once into key order in place.
+// Already ordered data is not reordered. Duplicates are removed.
+//
 // args:
 //        obss_t *obss (I,O) : observation data set structure
 //
@@ -65,6 +85,264 @@ int AddObs(obss_t *obss, const obs_t *obs);
 // -----------------------------------------------------------------------------
 void SortObss(obss_t *obss);
 
+// =============================================================================
+// Observation column data structure functions
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// Initialize observation column data structure
+//
+// args:
+//        obsCols_t *cols (I,O) : observation column data structure
+//
+// return:
+//        void            (-)   : no return value
+// -----------------------------------------------------------------------------
+void InitObsCols(obsCols_t *cols);
+
+// -----------------------------------------------------------------------------
+// Free observation column data structure
+//
+// args:
+//        obsCols_t *cols (I) : observation column data structure
+//
+// return:
+//        void            (-) : no return value
+// -----------------------------------------------------------------------------
+void FreeObsCols(obsCols_t *cols);
+
+// -----------------------------------------------------------------------------
+// Add observation data to observation column data (as the last row)
+//
+// args:
+//        obsCols_t *cols (I,O) : observation column data structure
+//  const obs_t     *obs  (I)   : observation data to add
+//
+// return:
+//        int       info  (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int AddObsCols(obsCols_t *cols, const obs_t *obs);
+
+// -----------------------------------------------------------------------------
+// Get observation data of a row of observation column data
+//
+// args:
+//  const obsCols_t *cols (I) : observation column data structure
+//        int       i     (I) : row index (0 to cols->n - 1)
+//        obs_t     *obs  (O) : observation data
+//
+// return:
+//        int       info  (O) : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int GetObsCols(const obsCols_t *cols, int i, obs_t *obs);
+
+// -----------------------------------------------------------------------------
+// Convert observation data set to observation column data
+//
+// The previous column data is replaced; rows keep the order of obss.
+//
+// args:
+//  const obss_t    *obss (I)   : observation data set structure
+//        obsCols_t *cols (I,O) : observation column data structure
+//
+// return:
+//        int       info  (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int Obss2Cols(const obss_t *obss, obsCols_t *cols);
+
+// -----------------------------------------------------------------------------
+// Convert observation column data to observation data set
+//
+// The previous observation data is replaced; records keep the row order.
+//
+// args:
+//  const obsCols_t *cols (I)   : observation column data structure
+//        obss_t    *obss (I,O) : observation data set structure
+//
+// return:
+//        int       info  (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int Cols2Obss(const obsCols_t *cols, obss_t *obss);
+
+// =============================================================================
+// Observation epoch index functions
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// Initialize observation epoch index structure
+//
+// args:
+//        obsEpochs_t *epochs (I,O) : observation epoch index structure
+//
+// return:
+//        void                (-)   : no return value
+// -----------------------------------------------------------------------------
+void InitObsEpochs(obsEpochs_t *epochs);
+
+// -----------------------------------------------------------------------------
+// Free observation epoch index structure
+//
+// args:
+//        obsEpochs_t *epochs (I) : observation epoch index structure
+//
+// return:
+//        void                (-) : no return value
+// -----------------------------------------------------------------------------
+void FreeObsEpochs(obsEpochs_t *epochs);
+
+// -----------------------------------------------------------------------------
+// Build observation epoch index of sorted observation data set
+//
+// Each run of observation data with the same time and receiver index becomes
+// one epoch (first, count). obss must be sorted by SortObss, and the index is
+// valid until obss is modified. The previous index is replaced.
+//
+// args:
+//  const obss_t      *obss   (I)   : observation data set structure (sorted)
+//        obsEpochs_t *epochs (I,O) : observation epoch index structure
+//
+// return:
+//        int         info    (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int IndexObsEpochs(const obss_t *obss, obsEpochs_t *epochs);
+
+// -----------------------------------------------------------------------------
+// Find observation epoch by time and receiver index (binary search)
+//
+// args:
+//  const obsEpochs_t *epochs (I) : observation epoch index structure
+//        double      time    (I) : standard time (GPST)
+//        int         rcv     (I) : receiver index
+//        double      tol     (I) : time tolerance [s]
+//
+// return:
+//        int         i       (O) : epoch index of the closest epoch within tol
+//                                  (-1 if not found)
+// -----------------------------------------------------------------------------
+int FindObsEpoch(const obsEpochs_t *epochs, double time, int rcv, double tol);
+
+// -----------------------------------------------------------------------------
+// Get observation data of an observation epoch (no copy)
+//
+// args:
+//  const obss_t      *obss   (I) : observation data set structure
+//  const obsEpochs_t *epochs (I) : observation epoch index of obss
+//        int         i       (I) : epoch index
+//        int         *n      (O) : number of observation data of the epoch
+//
+// return:
+//  const obs_t       *obs    (O) : first observation data of the epoch in obss
+//                                  (NULL if error)
+// -----------------------------------------------------------------------------
+const obs_t *GetObsEpoch(const obss_t *obss, const obsEpochs_t *epochs, int i, int *n);
+
+// -----------------------------------------------------------------------------
+// Get observation data of next observation epoch (no copy)
+//
+// Iterates the epochs in (time, receiver index) order; set *iter to 0 before
+// the first call.
+//
+// args:
+//  const obss_t      *obss   (I)   : observation data set structure
+//  const obsEpochs_t *epochs (I)   : observation epoch index of obss
+//        int         *iter   (I,O) : iterator (next epoch index)
+//        int         *n      (O)   : number of observation data of the epoch
+//
+// return:
+//  const obs_t       *obs    (O)   : first observation data of the epoch in obss
+//                                    (NULL if end of epochs)
+// -----------------------------------------------------------------------------
+const obs_t *NextObsEpoch(const obss_t *obss, const obsEpochs_t *epochs, int *iter, int *n);
+
+// =============================================================================
+// Compact observation data functions
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// Initialize compact observation data structure
+//
+// args:
+//        obsPack_t *pack (I,O) : compact observation data structure
+//
+// return:
+//        void            (-)   : no return value
+// -----------------------------------------------------------------------------
+void InitObsPack(obsPack_t *pack);
+
+// -----------------------------------------------------------------------------
+// Free compact observation data structure
+//
+// args:
+//        obsPack_t *pack (I) : compact observation data structure
+//
+// return:
+//        void            (-) : no return value
+// -----------------------------------------------------------------------------
+void FreeObsPack(obsPack_t *pack);
+
+// -----------------------------------------------------------------------------
+// Encode observation data and add to compact observation data
+//
+// Only frequencies with data are stored. Time and receiver index are stored
+// only when they change from the previous record, and values with at most 3
+// decimals (as in RINEX) are stored as variable-length integers of 0.001
+// units (other pseudoranges relative to the first one of the record); other
+// values are stored as they are, so decoding is exact.
+//
+// args:
+//        obsPack_t *pack (I,O) : compact observation data structure
+//  const obs_t     *obs  (I)   : observation data to add
+//
+// return:
+//        int       info  (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int AddObsPack(obsPack_t *pack, const obs_t *obs);
+
+// -----------------------------------------------------------------------------
+// Decode next observation data of compact observation data
+//
+// Records are decoded in order; set *pos to 0 before the first call and pass
+// the same obs to every call (the time and receiver index of the previous
+// record are taken from it).
+//
+// args:
+//  const obsPack_t *pack (I)   : compact observation data structure
+//        size_t    *pos  (I,O) : position of next record in pack->data
+//        obs_t     *obs  (I,O) : previous/decoded observation data
+//
+// return:
+//        int       info  (O)   : 1 if decoded, 0 if end of data or failed
+// -----------------------------------------------------------------------------
+int NextObsPack(const obsPack_t *pack, size_t *pos, obs_t *obs);
+
+// -----------------------------------------------------------------------------
+// Convert observation data set to compact observation data
+//
+// The previous compact data is replaced; records keep the order of obss.
+//
+// args:
+//  const obss_t    *obss (I)   : observation data set structure
+//        obsPack_t *pack (I,O) : compact observation data structure
+//
+// return:
+//        int       info  (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int Obss2Pack(const obss_t *obss, obsPack_t *pack);
+
+// -----------------------------------------------------------------------------
+// Convert compact observation data to observation data set
+//
+// The previous observation data is replaced; records keep the encoded order.
+//
+// args:
+//  const obsPack_t *pack (I)   : compact observation data structure
+//        obss_t    *obss (I,O) : observation data set structure
+//
+// return:
+//        int       info  (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int Pack2Obss(const obsPack_t *pack, obss_t *obss);
+
 // =============================================================================
 // Observation code conversion functions
 // =============================================================================
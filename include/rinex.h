@@ -11,6 +11,40 @@
 // GNSS library
 #include "types.h"
 
+// =============================================================================
+// Type definitions
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// Observation record callback
+//
+// args:
+// const obs_t   *obs      (I)   : observation record (valid during the call)
+//       void    *data     (I,O) : user data
+//
+// return:
+//       int     info      (O)   : 1 to continue, 0 to stop reading
+// -----------------------------------------------------------------------------
+typedef int (*rnxObsFunc_t)(const obs_t *obs, void *data);
+
+// -----------------------------------------------------------------------------
+// Observation epoch callback
+//
+// args:
+// const obss_t  *epoch    (I)   : epoch observation data (sorted by satellite,
+//                                 valid during the call)
+//       void    *data     (I,O) : user data
+//
+// return:
+//       int     info      (O)   : 1 to continue, 0 to stop reading
+// -----------------------------------------------------------------------------
+typedef int (*rnxEpochFunc_t)(const obss_t *epoch, void *data);
+
+// -----------------------------------------------------------------------------
+// RINEX observation stream (opaque, see OpenRnxObs)
+// -----------------------------------------------------------------------------
+typedef struct rnxObsStream rnxObsStream_t;
+
 // =============================================================================
 // RINEX check functions
 // =============================================================================
@@ -18,6 +52,9 @@
 // -----------------------------------------------------------------------------
 // Check if file name is the RINEX obs file name
 //
+// RINEX (.XXo, .rnx) and compact RINEX (.XXd, .crx) names are accepted, also
+// with compression extension (.gz, .Z).
+//
 // args:
 // const char    *filename (I)   : file name
 //
@@ -29,6 +66,8 @@ int IsRinexObs(const char *filename);
 // -----------------------------------------------------------------------------
 // Check if file name is the RINEX navigation file name
 //
+// Names with compression extension (.gz, .Z) are also accepted.
+//
 // args:
 // const char    *filename (I)   : file name
 //
@@ -55,6 +94,119 @@ int IsRinexNav(const char *filename);
 // -----------------------------------------------------------------------------
 int ReadRnxObs(nav_t *nav, obss_t *obs, int rcvidx, const char *filename);
 
+// -----------------------------------------------------------------------------
+// Read RINEX observation file with parallel body parsing (support version 2.xx
+// and 3.xx)
+//
+// The body is split at epoch block boundaries into nthread slices that are
+// parsed on separate threads (pthreads) and appended to obs in file order, so
+// a time-ordered file needs no reordering by SortObss. Falls back to
+// ReadRnxObs if nthread <= 1 or on Windows.
+//
+// args:
+//       nav_t   *nav      (I,O) : navigation data structure
+//       obss_t  *obs      (I,O) : observation data structure
+//       int     rcvidx    (I)   : receiver index
+// const char    *filename (I)   : file name
+//       int     nthread   (I)   : number of threads
+//
+// return:
+//       int     info      (O)   : 1 if successful, 0 if failed
+// -----------------------------------------------------------------------------
+int ReadRnxObsPar(nav_t *nav, obss_t *obs, int rcvidx, const char *filename, int nthread);
+
+// -----------------------------------------------------------------------------
+// Read RINEX observation file in chunks (support version 2.xx and 3.xx)
+//
+// The body is read in fixed-size chunks and parsed epoch block by epoch block,
+// so memory use is bounded by the chunk size instead of the file size (the
+// chunk grows only if a single epoch block does not fit). Records are passed
+// to func if given, otherwise added to obs (not sorted).
+//
+// args:
+//       nav_t        *nav      (I,O) : navigation data structure
+//       obss_t       *obs      (I,O) : observation data structure (NULL if func)
+//       int          rcvidx    (I)   : receiver index
+// const char         *filename (I)   : file name
+//       rnxObsFunc_t func      (I)   : observation record callback (NULL: add to obs)
+//       void         *data     (I,O) : user data for func
+//
+// return:
+//       int          info      (O)   : 1 if successful, 0 if failed or stopped by func
+// -----------------------------------------------------------------------------
+int ReadRnxObsStream(nav_t *nav, obss_t *obs, int rcvidx, const char *filename,
+                     rnxObsFunc_t func, void *data);
+
+// -----------------------------------------------------------------------------
+// Open RINEX observation file for epoch-by-epoch reading (support version 2.xx
+// and 3.xx)
+//
+// Reads the header and copies the station information to nav->sta[rcvidx-1].
+// The body is read in chunks by NextRnxObs; no full-file state is kept.
+//
+// args:
+//       nav_t          *nav      (I,O) : navigation data structure
+//       int            rcvidx    (I)   : receiver index (1 to NRCV)
+// const char           *filename (I)   : file name
+//
+// return:
+//       rnxObsStream_t *stream   (O)   : observation stream (NULL if failed)
+// -----------------------------------------------------------------------------
+rnxObsStream_t *OpenRnxObs(nav_t *nav, int rcvidx, const char *filename);
+
+// -----------------------------------------------------------------------------
+// Read next epoch of RINEX observation file
+//
+// The returned observations (sorted by satellite) are owned by the stream and
+// overwritten by the next call. Epochs without valid data are skipped.
+//
+// args:
+//       rnxObsStream_t *stream   (I,O) : observation stream
+//
+// return:
+//       obss_t         *obs      (O)   : epoch observation data (NULL if end of
+//                                        file or failed)
+// -----------------------------------------------------------------------------
+const obss_t *NextRnxObs(rnxObsStream_t *stream);
+
+// -----------------------------------------------------------------------------
+// Close RINEX observation file
+//
+// args:
+//       rnxObsStream_t *stream   (I)   : observation stream
+//
+// return:
+//       void                     (-)   : no return value
+// -----------------------------------------------------------------------------
+void CloseRnxObs(rnxObsStream_t *stream);
+
+// -----------------------------------------------------------------------------
+// Follow growing RINEX observation file (support version 2.xx and 3.xx)
+//
+// For files written incrementally by a receiver. The file is kept open and
+// each epoch is passed to func as soon as its block is completely written;
+// the chunk keeps the offset of the last complete epoch block, so appended
+// data are parsed once and the file is never re-read. At the end of the file
+// the file is polled every interval seconds. The header must be complete at
+// the call and the file must not be compressed.
+//
+// args:
+//       nav_t          *nav      (I,O) : navigation data structure
+//       int            rcvidx    (I)   : receiver index (1 to NRCV)
+// const char           *filename (I)   : file name
+//       rnxEpochFunc_t func      (I)   : observation epoch callback
+//       void           *data     (I,O) : user data for func
+//       double         interval  (I)   : poll interval [s] (min. 0.01 s)
+//       double         timeout   (I)   : time without appended epochs to stop
+//                                        following [s] (0: no timeout)
+//
+// return:
+//       int            info      (O)   : 1 if stopped by func, 2 if stopped by
+//                                        timeout, 0 if failed
+// -----------------------------------------------------------------------------
+int FollowRnxObs(nav_t *nav, int rcvidx, const char *filename, rnxEpochFunc_t func,
+                 void *data, double interval, double timeout);
+
 // -----------------------------------------------------------------------------
 // Read RINEX navigation file (support version 2.xx and 3.xx)
 //
@@ -17,6 +17,7 @@ extern "C" {
 void InitSigs(sigs_t *sigs);
 void FreeSigs(sigs_t *sigs);
 int  AddSig(sigs_t *sigs, const sig_t *sig);
+int  ReserveSigs(sigs_t *sigs, int n);
 void SortSigs(sigs_t *sigs);
 int  FindSig(const sigs_t *sigs, double time, int rcv, int sat);
 
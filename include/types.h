@@ -72,6 +72,8 @@ typedef struct opt {
     int minlock;                        // Minimum lock count to fix ambiguity
     double ts;                          // Processing time start [s] (0.0: all)
     double te;                          // Processing time end [s] (0.0: all)
+    double ti;                          // Processing time interval [s] (0.0: all)
+    int obscache;                       // Observation cache file (<file>.obc) of ReadObsFiles (0: off, 1: on)
     double err;                         // Carrier phase measurement error std [m] (zenith direction)
     double errratio;                    // Pseudorange measurement error ratio;
     double procnoiseAmb;                // Phase ambiguity [cycle]
@@ -89,6 +91,7 @@ typedef struct opt {
     double elmask;                      // Elevation mask angle [rad]
     double maxgdop;                     // Maximum GDOP
     int exsats[NSAT];                   // Excluded satellites (!0: excluded)
+    int rdexsats[NSAT];                 // Satellites excluded when reading observations (!0: excluded)
 } opt_t;
 
 // -----------------------------------------------------------------------------
@@ -159,14 +162,63 @@ typedef struct eph {
     double ttr;                         // Time to transmission (GPST) (Standard time)
 } eph_t;
 
+// -----------------------------------------------------------------------------
+// Struct of ephemeris time index key
+// -----------------------------------------------------------------------------
+typedef struct ephKey {
+    double ttr;                         // Time to transmission (GPST) (Standard time)
+    double toemax;                      // Maximum toe of this and preceding keys (GPST)
+    int    i;                           // Index of ephemeris data
+} ephKey_t;
+
+// -----------------------------------------------------------------------------
+// Struct of prepared Keplerian ephemeris (64 bytes, one cache line)
+// -----------------------------------------------------------------------------
+typedef struct ephPrep {
+    double n;                           // Corrected mean motion (rad/s)
+    double sqrte;                       // sqrt(1 - e^2)
+    double frel;                        // Relativistic clock factor 2*sqrt(mu*A)*e (m)
+    double OMGd;                        // Rate of longitude of ascending node (rad/s)
+                                        // (OMGd - omge, BDS GEO: OMGd)
+    double OMGt;                        // Earth's rotation angle at toe omge*toes (rad)
+    double omge;                        // Earth's angular rate (rad/s)
+    double ura;                         // URA/SISA value (m) (negative if invalid)
+    int    geo;                         // BeiDou GEO satellite flag (0: no, 1: yes)
+    int    valid;                       // Prepared Keplerian ephemeris (0: no, 1: yes)
+} ephPrep_t;
+
+// -----------------------------------------------------------------------------
+// Struct of ephemeris selection cache
+// -----------------------------------------------------------------------------
+typedef struct ephCache {
+    int    idx;                         // Index of selected ephemeris data (-1: no cache)
+    int    iode;                        // IODE of selection (-1: any IODE)
+    int    stamp;                       // Index stamp of ephemeris data set at selection
+    double tmin, tmax;                  // Validity interval of selection [tmin, tmax) (GPST)
+} ephCache_t;
+
 // -----------------------------------------------------------------------------
 // Struct of ephemeris data set
 // -----------------------------------------------------------------------------
 typedef struct ephs {
-    int    n, nmax;                     // Number of ephemeris/allocated memory
-    eph_t  *eph;                        // Ephemeris data
+    int       n, nmax;                  // Number of ephemeris/allocated memory
+    eph_t     *eph;                     // Ephemeris data
+    int       nidx;                     // Number of ephemeris data indexed (-1: no index)
+    int       nkey[NEPHSRC];            // Number of index keys per ephemeris source
+    ephKey_t  *key[NEPHSRC];            // Index keys sorted by ttr per ephemeris source
+                                        // (0: default or GAL I/NAV, 1: GAL F/NAV)
+    int       stamp;                    // Index stamp (changed when the index is rebuilt)
+    int       nprep;                    // Number of allocated prepared ephemeris
+    ephPrep_t *prep;                    // Prepared ephemeris of indexed ephemeris data
 } ephs_t;
 
+// -----------------------------------------------------------------------------
+// Struct of ephemeris selection cache of caller (see SelectEphSel)
+// -----------------------------------------------------------------------------
+typedef struct ephSel {
+    ephCache_t cache[NSAT][NEPHSRC];    // Last selection per satellite and ephemeris source
+} ephSel_t;
+
 // -----------------------------------------------------------------------------
 // Struct of navigation data
 // -----------------------------------------------------------------------------
@@ -178,6 +230,21 @@ typedef struct nav {
     opt_t     *opt;                     // Processing options
 } nav_t;
 
+// -----------------------------------------------------------------------------
+// Struct of satellite positions, velocities and clocks (structure of arrays)
+//
+// Output arrays of SatPosClkBrdcBatch allocated by the caller. Element i of every
+// array is the i-th satellite. Arrays set to NULL are not output.
+// -----------------------------------------------------------------------------
+typedef struct satPosClks {
+    double *pos[3];                     // Satellite position x/y/z (ECEF) [m]
+    double *vel[3];                     // Satellite velocity x/y/z (ECEF) [m/s]
+    double *dts;                        // Satellite clock bias [s]
+    double *ddts;                       // Satellite clock drift [s/s]
+    double *var;                        // Variance of position and clock bias [m^2]
+    int    *stat;                       // Status (1:ok, 0:error)
+} satPosClks_t;
+
 // -----------------------------------------------------------------------------
 // Struct of observation data
 // -----------------------------------------------------------------------------
@@ -201,6 +268,54 @@ typedef struct obss {
     obs_t  *obs;                       // Observation data
 } obss_t;
 
+// -----------------------------------------------------------------------------
+// Struct of observation data set in columns (structure of arrays)
+//
+// Row i of every column is the i-th observation data, so one observable of
+// all observations (e.g. P[0][0..n-1]) is contiguous in memory.
+// -----------------------------------------------------------------------------
+typedef struct obsCols {
+    int    n, nmax;                     // Number of observations/allocated memory
+    double *time;                       // Standard time (GPST)
+    int    *rcv;                        // Receiver index
+    int    *sat;                        // Satellite index
+    int    *code[NFREQ];                // Observation code index
+    double *P   [NFREQ];                // Pseudorange [m]
+    double *L   [NFREQ];                // Carrier phase [cycle]
+    double *D   [NFREQ];                // Doppler frequency [Hz]
+    double *SNR [NFREQ];                // Signal-to-noise ratio [dB]
+    int    *LLI [NFREQ];                // Loss of lock indicator
+} obsCols_t;
+
+// -----------------------------------------------------------------------------
+// Struct of observation epoch (observation data block of a receiver at a time)
+// -----------------------------------------------------------------------------
+typedef struct obsEpoch {
+    double time;                        // Standard time (GPST)
+    int    rcv;                         // Receiver index
+    int    first;                       // Index of first observation data in obss
+    int    count;                       // Number of observation data
+} obsEpoch_t;
+
+// -----------------------------------------------------------------------------
+// Struct of observation epoch index
+// -----------------------------------------------------------------------------
+typedef struct obsEpochs {
+    int        n, nmax;                 // Number of epochs/allocated memory
+    obsEpoch_t *epoch;                  // Observation epochs (time, rcv order)
+} obsEpochs_t;
+
+// -----------------------------------------------------------------------------
+// Struct of compact observation data set (variable-length encoded records)
+// -----------------------------------------------------------------------------
+typedef struct obsPack {
+    int           n;                    // Number of observation data
+    size_t        size, nmax;           // Size of encoded data/allocated memory [bytes]
+    unsigned char *data;                // Encoded observation data
+    double        time;                 // Time of last added observation data
+    int           rcv;                  // Receiver index of last added observation data
+} obsPack_t;
+
 // -----------------------------------------------------------------------------
 // Struct of solution data
 // -----------------------------------------------------------------------------
@@ -406,6 +521,8 @@ typedef struct buffer {
     char        *buff;                  // Full buffer
     lineinfo_t  *lineinfo;              // Line information
     size_t      nline;                  // Number of lines
+    size_t      size;                   // Buffer size [bytes]
+    int         map;                    // Buffer mode (0: heap, 1: memory-mapped, read-only)
 } buffer_t;
 
 // =============================================================================
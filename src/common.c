@@ -20,6 +20,7 @@
 #include "matrix.h"                     // for matrix functions
 #include "option.h"                     // for SetDefaultOpt
 #include "obs.h"                        // for Fidx2Band, Str2Band
+#include "ephemeris.h"                  // for InitEphs, FreeEphs
 
 // =============================================================================
 // Macros
@@ -171,8 +172,7 @@ int InitNav(nav_t *nav)
 
     // Initialize broadcast ephemeris data
     for (int i = 0; i < NSAT; i++) {
-        nav->ephs[i].n = nav->ephs[i].nmax = 0;
-        nav->ephs[i].eph = NULL;
+        InitEphs(&nav->ephs[i]);
     }
 
     // Initialize data of antenna parameters
@@ -206,11 +206,7 @@ void FreeNav(nav_t *nav)
 {
     // Free broadcast ephemeris data
     for (int i = 0; i < NSAT; i++) {
-        if (nav->ephs[i].eph != NULL) {
-            free(nav->ephs[i].eph);
-            nav->ephs[i].eph = NULL;
-            nav->ephs[i].n = nav->ephs[i].nmax = 0;
-        }
+        FreeEphs(&nav->ephs[i]);
     }
 
     // Free antenna parameters data
@@ -0,0 +1,1270 @@
+// =============================================================================
+// Decompression functions
+//
+// Streaming decoders for archived observation files. Decoders are layered:
+//
+//   file or memory -> gzip (deflate) / UNIX compress (LZW) / plain bytes
+//                  -> compact RINEX (Hatanaka CRINEX 1.0/3.0) / plain text
+//
+// Each layer pulls from the one below into a fixed buffer, so a file is
+// decoded in one pass without temporary files or external processes.
+// -----------------------------------------------------------------------------
+// Yongrae Jo, 0727ggame@sju.ac.kr
+// =============================================================================
+
+// Standard library
+#include <stdlib.h>                     // for malloc, calloc, realloc, free
+#include <string.h>                     // for memcpy, memmove, memchr, memset, strchr
+#include <stdio.h>                      // for fopen, fread, ferror, clearerr, fclose
+#include <stdint.h>                     // for uint8_t, uint16_t, uint32_t, uint64_t, int64_t
+
+// GNSS library
+#include "decomp.h"
+#include "files.h"                      // for FreeBuff
+
+// =============================================================================
+// Macros
+// =============================================================================
+
+#define DEC_IN_SIZE    (1 << 16)        // Input buffer size [bytes]
+#define DEC_RAW_SIZE   (1 << 18)        // Decoded byte buffer size [bytes]
+#define DEC_WIN_SIZE   (1 << 15)        // Deflate window size [bytes]
+#define DEC_MAX_MATCH  258              // Maximum deflate match length [bytes]
+#define DEC_LUT_BITS   10               // Huffman lookup table bits
+#define LZW_MAX_BITS   16               // Maximum LZW code bits
+
+#define DEC_PLAIN      0                // Byte format: plain
+#define DEC_GZIP       1                // Byte format: gzip
+#define DEC_LZW        2                // Byte format: UNIX compress
+
+#define CRX_LABEL      "CRINEX VERS   / TYPE" // CRINEX header label of first line
+#define CRX_MAX_LINE   4096             // Maximum CRINEX line length
+#define CRX_MAX_TYPE   64               // Maximum number of observation types
+#define CRX_MAX_ORDER  9                // Maximum difference order
+#define CRX_SYS_STR    "GRECJIS"        // Systems of satellite state slots
+#define CRX_NSYS       7                // Number of systems of satellite state slots
+#define CRX_MAX_SAT    (CRX_NSYS * 100) // Number of satellite state slots (system x PRN)
+
+// =============================================================================
+// Static type definitions
+// =============================================================================
+
+typedef struct huff {                       // Huffman decoding table (deflate)
+    uint16_t count[16];                     // Number of codes of each length
+    uint16_t symbol[288];                   // Symbols in canonical code order
+    uint16_t lut[1 << DEC_LUT_BITS];        // Short codes (symbol << 4 | length, 0: long)
+} huff_t;
+
+typedef struct crxArc {                     // CRINEX data arc of one field
+    int     order;                          // Current difference order (-1: no data)
+    int     arcOrder;                       // Difference order of the arc
+    int64_t d[CRX_MAX_ORDER + 1];           // Value and its differences
+} crxArc_t;
+
+typedef struct crxSat {                     // CRINEX satellite state
+    int      epoch;                         // Index of last epoch with the satellite
+    crxArc_t arc[CRX_MAX_TYPE];             // Data arcs of observation types
+    char     flag[2 * CRX_MAX_TYPE + 1];    // LLI and SSI flags of observation types
+} crxSat_t;
+
+struct decomp {                             // Decompression stream structure (decomp.h)
+
+    // Input bytes (file or memory)
+    FILE          *fp;                      // File pointer (NULL: memory)
+    const uint8_t *in;                      // Input data
+    uint8_t       *ibuf;                    // Input buffer of file
+    size_t        ipos, isize;              // Next input byte/number of input bytes
+    int           ieof;                     // End of file flag
+
+    // Bit reader (LSB first)
+    uint64_t      bitbuf;                   // Bit buffer
+    int           bitcnt;                   // Number of bits in bit buffer
+    int           pad;                      // Number of zero bits padded after end of input
+
+    // Decoded bytes
+    int           type;                     // Byte format (DEC_PLAIN, DEC_GZIP, DEC_LZW)
+    uint8_t       *raw;                     // Decoded byte buffer
+    size_t        rbeg, rend;               // Unread decoded bytes
+    int           reof;                     // End of decoded bytes flag
+
+    // Deflate (gzip)
+    int           last;                     // Last block flag
+    int           block;                    // Block type (-1: header, 0: stored, 1: Huffman)
+    size_t        stored;                   // Remaining bytes of stored block
+    huff_t        lcode, dcode;             // Literal/length and distance codes
+    uint8_t       *win;                     // Sliding window
+    uint32_t      wpos;                     // Window position
+    uint32_t      crc;                      // CRC-32 of member
+    uint32_t      total;                    // Size of member (mod 2^32)
+    uint32_t      crctab[256];              // CRC-32 table
+
+    // LZW (UNIX compress)
+    uint16_t      *prefix;                  // Prefix code of table entries
+    uint8_t       *suffix;                  // Suffix byte of table entries
+    uint8_t       *stack;                   // Decoded string stack
+    int           nbits, maxbits;           // Current/maximum code bits
+    int           blockMode;                // Block mode (CLEAR code enabled)
+    int           freeEnt, maxcode, oldcode;// Next free entry/maximum code/previous code
+    int           finchar;                  // First byte of previous string
+    uint64_t      posbits;                  // Bits read since code group origin
+
+    // Compact RINEX
+    int           crx;                      // CRINEX version (0: none, 1: 1.0, 3: 3.0)
+    int           hdr;                      // Header state (0: CRINEX lines, 1: RINEX, 2: body)
+    int           ntype[CRX_NSYS];          // Number of observation types per system
+    char          epoch[CRX_MAX_LINE];      // Previous epoch line
+    crxArc_t      clk;                      // Receiver clock offset arc
+    crxSat_t      *sat[CRX_MAX_SAT];        // Satellite states
+    int           nep;                      // Number of data epochs
+    char          *text;                    // Restored RINEX text
+    size_t        tbeg, tend, tcap;         // Unread text/text capacity
+
+    int           err;                      // Error flag
+};
+
+// =============================================================================
+// Static global variables
+// =============================================================================
+
+// Deflate length and distance bases and extra bits
+static const uint16_t LBASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99,
+    115, 131, 163, 195, 227, 258
+};
+static const uint8_t LEXT[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t DBASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025,
+    1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t DEXT[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12,
+    12, 13, 13
+};
+
+// Order of code length code lengths (deflate)
+static const uint8_t CLORDER[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+// =============================================================================
+// Static functions (internal use only)
+// =============================================================================
+
+// Refill input buffer from file (1: data available, 0: end of input)
+static int FillIn(decomp_t *dec)
+{
+    if (!dec->fp || dec->ieof) return 0;
+
+    dec->isize = fread(dec->ibuf, 1, DEC_IN_SIZE, dec->fp);
+    dec->ipos = 0;
+    if (dec->isize < DEC_IN_SIZE) {
+        if (ferror(dec->fp)) dec->err = 1;
+        dec->ieof = 1;
+    }
+    return dec->isize > 0;
+}
+
+// Get next input byte (-1: end of input)
+static inline int GetByte(decomp_t *dec)
+{
+    if (dec->ipos >= dec->isize && !FillIn(dec)) return -1;
+    return dec->in[dec->ipos++];
+}
+
+// Copy input bytes (return: number of bytes copied, less than n at end of input)
+static size_t ReadIn(decomp_t *dec, uint8_t *dst, size_t n)
+{
+    size_t k = dec->isize - dec->ipos;
+    if (k > n) k = n;
+    memcpy(dst, dec->in + dec->ipos, k);
+    dec->ipos += k;
+
+    // Read the rest directly from file
+    if (k < n && dec->fp && !dec->ieof) {
+        size_t nread = fread(dst + k, 1, n - k, dec->fp);
+        if (nread < n - k) {
+            if (ferror(dec->fp)) dec->err = 1;
+            dec->ieof = 1;
+        }
+        k += nread;
+    }
+    return k;
+}
+
+// Fill bit buffer with at least n bits, padding zeros after end of input
+// (1: n bits of input available, 0: end of input)
+static inline int NeedBits(decomp_t *dec, int n)
+{
+    while (dec->bitcnt < n) {
+        int c = GetByte(dec);
+        if (c < 0) {
+            c = 0;
+            dec->pad += 8;
+        }
+        dec->bitbuf |= (uint64_t)c << dec->bitcnt;
+        dec->bitcnt += 8;
+    }
+    return dec->bitcnt - dec->pad >= n;
+}
+
+// Get n bits (n <= 32)
+static inline uint32_t GetBits(decomp_t *dec, int n)
+{
+    NeedBits(dec, n);
+    uint32_t v = (uint32_t)(dec->bitbuf & ((1ULL << n) - 1));
+    dec->bitbuf >>= n;
+    dec->bitcnt -= n;
+    return v;
+}
+
+// Skip to next byte boundary of bit buffer
+static inline void AlignBits(decomp_t *dec)
+{
+    int n = dec->bitcnt & 7;
+    dec->bitbuf >>= n;
+    dec->bitcnt -= n;
+}
+
+// Check if bits beyond end of input were used (1: overrun)
+static inline int OverBits(const decomp_t *dec)
+{
+    return dec->pad > dec->bitcnt;
+}
+
+// Update CRC-32 with data
+static uint32_t Crc32(const uint32_t *tab, uint32_t crc, const uint8_t *data, size_t n)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < n; i++) crc = tab[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// Put decoded byte of deflate or LZW
+static inline void PutRaw(decomp_t *dec, int c)
+{
+    dec->raw[dec->rend++] = (uint8_t)c;
+}
+
+// Build Huffman decoding table from code lengths (1: success, 0: over-subscribed)
+static int BuildHuff(huff_t *h, const uint8_t *len, int n)
+{
+    uint16_t offs[16];
+
+    memset(h->count, 0, sizeof(h->count));
+    for (int i = 0; i < n; i++) h->count[len[i]]++;
+    h->count[0] = 0;
+
+    // Check over-subscribed code (incomplete codes are decoded until unused code)
+    int left = 1;
+    for (int l = 1; l < 16; l++) {
+        left = (left << 1) - h->count[l];
+        if (left < 0) return 0;
+    }
+
+    // Symbols in canonical code order
+    offs[1] = 0;
+    for (int l = 1; l < 15; l++) offs[l + 1] = offs[l] + h->count[l];
+    for (int i = 0; i < n; i++) {
+        if (len[i]) h->symbol[offs[len[i]]++] = (uint16_t)i;
+    }
+
+    // Lookup table of short codes (indexed by bit-reversed code)
+    memset(h->lut, 0, sizeof(h->lut));
+    int code = 0, idx = 0;
+    for (int l = 1; l <= DEC_LUT_BITS; l++) {
+        for (int k = 0; k < h->count[l]; k++, idx++, code++) {
+            int rev = 0;
+            for (int b = 0; b < l; b++) rev |= ((code >> b) & 1) << (l - 1 - b);
+            for (int j = rev; j < (1 << DEC_LUT_BITS); j += 1 << l) {
+                h->lut[j] = (uint16_t)(h->symbol[idx] << 4 | l);
+            }
+        }
+        code <<= 1;
+    }
+    return 1;
+}
+
+// Decode Huffman symbol (-1: invalid code)
+static int DecodeSym(decomp_t *dec, const huff_t *h)
+{
+    NeedBits(dec, 15);
+
+    // Short code by lookup table
+    int e = h->lut[dec->bitbuf & ((1 << DEC_LUT_BITS) - 1)];
+    if (e) {
+        dec->bitbuf >>= (e & 15);
+        dec->bitcnt -= (e & 15);
+        return e >> 4;
+    }
+
+    // Long code by canonical code walk
+    int code = 0, first = 0, index = 0;
+    for (int l = 1; l < 16; l++) {
+        code |= (int)(dec->bitbuf >> (l - 1)) & 1;
+        int count = h->count[l];
+        if (code - count < first) {
+            dec->bitbuf >>= l;
+            dec->bitcnt -= l;
+            return h->symbol[index + (code - first)];
+        }
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+// Set fixed Huffman codes of deflate
+static void FixedHuff(decomp_t *dec)
+{
+    uint8_t len[288];
+
+    for (int i =   0; i < 144; i++) len[i] = 8;
+    for (int i = 144; i < 256; i++) len[i] = 9;
+    for (int i = 256; i < 280; i++) len[i] = 7;
+    for (int i = 280; i < 288; i++) len[i] = 8;
+    BuildHuff(&dec->lcode, len, 288);
+
+    for (int i = 0; i < 30; i++) len[i] = 5;
+    BuildHuff(&dec->dcode, len, 30);
+}
+
+// Read dynamic Huffman codes of deflate (1: success, 0: failure)
+static int DynamicHuff(decomp_t *dec)
+{
+    uint8_t len[320];
+
+    int nlen  = (int)GetBits(dec, 5) + 257;
+    int ndist = (int)GetBits(dec, 5) + 1;
+    int ncode = (int)GetBits(dec, 4) + 4;
+    if (nlen > 286 || ndist > 30) return 0;
+
+    // Code length code (built into literal/length table temporarily)
+    memset(len, 0, 19);
+    for (int i = 0; i < ncode; i++) len[CLORDER[i]] = (uint8_t)GetBits(dec, 3);
+    if (!BuildHuff(&dec->lcode, len, 19)) return 0;
+
+    // Literal/length and distance code lengths
+    for (int i = 0; i < nlen + ndist; ) {
+        int sym = DecodeSym(dec, &dec->lcode);
+        if (sym < 0 || OverBits(dec)) return 0;
+
+        if (sym < 16) {
+            len[i++] = (uint8_t)sym;
+            continue;
+        }
+        int rep, val = 0;
+        if (sym == 16) {
+            if (i == 0) return 0;
+            val = len[i - 1];
+            rep = 3 + (int)GetBits(dec, 2);
+        }
+        else if (sym == 17) rep = 3 + (int)GetBits(dec, 3);
+        else rep = 11 + (int)GetBits(dec, 7);
+
+        if (i + rep > nlen + ndist) return 0;
+        while (rep--) len[i++] = (uint8_t)val;
+    }
+    if (len[256] == 0) return 0;
+
+    return BuildHuff(&dec->lcode, len, nlen) && BuildHuff(&dec->dcode, len + nlen, ndist);
+}
+
+// Read gzip member header (1: success, 0: failure)
+static int GzipHeader(decomp_t *dec)
+{
+    if (GetBits(dec, 16) != 0x8B1F || GetBits(dec, 8) != 8) return 0;
+
+    int flg = (int)GetBits(dec, 8);
+    GetBits(dec, 32);                       // Modification time
+    GetBits(dec, 16);                       // Extra flags and OS
+
+    if (flg & 4) {                          // Extra field
+        for (int n = (int)GetBits(dec, 16); n > 0 && !OverBits(dec); n--) GetBits(dec, 8);
+    }
+    if (flg & 8) {                          // File name
+        while (GetBits(dec, 8) != 0 && !OverBits(dec)) ;
+    }
+    if (flg & 16) {                         // Comment
+        while (GetBits(dec, 8) != 0 && !OverBits(dec)) ;
+    }
+    if (flg & 2) GetBits(dec, 16);          // Header CRC
+
+    dec->last = 0;
+    dec->block = -1;
+    dec->crc = 0;
+    dec->total = 0;
+
+    return !OverBits(dec);
+}
+
+// Check gzip member trailer and start next member (1: success, 0: failure)
+static int GzipTrailer(decomp_t *dec)
+{
+    AlignBits(dec);
+    uint32_t crc = GetBits(dec, 32);
+    uint32_t size = GetBits(dec, 32);
+    if (OverBits(dec) || crc != dec->crc || size != dec->total) return 0;
+
+    // Next member of concatenated gzip (trailing data other than a member is ignored)
+    if (NeedBits(dec, 16) && (dec->bitbuf & 0xFFFF) == 0x8B1F) return GzipHeader(dec);
+
+    dec->reof = 1;
+    return 1;
+}
+
+// Decode deflate data into decoded byte buffer (1: success, 0: failure)
+static int InflateRaw(decomp_t *dec)
+{
+    size_t r0 = dec->rend;
+
+    while (!dec->reof && DEC_RAW_SIZE - dec->rend >= DEC_MAX_MATCH) {
+
+        // Block header (or member trailer after last block)
+        if (dec->block < 0) {
+
+            if (dec->last) {
+                dec->crc = Crc32(dec->crctab, dec->crc, dec->raw + r0, dec->rend - r0);
+                dec->total += (uint32_t)(dec->rend - r0);
+                r0 = dec->rend;
+                if (!GzipTrailer(dec)) return 0;
+                continue;
+            }
+            dec->last = (int)GetBits(dec, 1);
+            int type = (int)GetBits(dec, 2);
+
+            if (type == 0) {
+                AlignBits(dec);
+                uint32_t len = GetBits(dec, 16);
+                uint32_t nlen = GetBits(dec, 16);
+                if (len != (~nlen & 0xFFFF)) return 0;
+                dec->stored = len;
+                dec->block = 0;
+            }
+            else if (type == 1) {
+                FixedHuff(dec);
+                dec->block = 1;
+            }
+            else if (type == 2) {
+                if (!DynamicHuff(dec)) return 0;
+                dec->block = 1;
+            }
+            else return 0;
+
+            if (OverBits(dec)) return 0;
+            continue;
+        }
+
+        // Stored block
+        if (dec->block == 0) {
+            for (; dec->stored > 0 && dec->rend < DEC_RAW_SIZE; dec->stored--) {
+                int c = (int)GetBits(dec, 8);
+                if (OverBits(dec)) return 0;
+                dec->win[dec->wpos++ & (DEC_WIN_SIZE - 1)] = (uint8_t)c;
+                PutRaw(dec, c);
+            }
+            if (dec->stored == 0) dec->block = -1;
+            continue;
+        }
+
+        // Literal, end of block or match (zero padding past end of input is
+        // never decoded as data)
+        int sym = DecodeSym(dec, &dec->lcode);
+        if (sym < 0 || OverBits(dec)) return 0;
+
+        if (sym < 256) {
+            dec->win[dec->wpos++ & (DEC_WIN_SIZE - 1)] = (uint8_t)sym;
+            PutRaw(dec, sym);
+        }
+        else if (sym == 256) {
+            dec->block = -1;
+        }
+        else {
+            if ((sym -= 257) >= 29) return 0;
+            int len = LBASE[sym] + (int)GetBits(dec, LEXT[sym]);
+            if (OverBits(dec)) return 0;
+            int ds = DecodeSym(dec, &dec->dcode);
+            if (ds < 0 || ds >= 30 || OverBits(dec)) return 0;
+            uint32_t dist = DBASE[ds] + GetBits(dec, DEXT[ds]);
+            if (OverBits(dec)) return 0;
+            if (dist > dec->total + (uint32_t)(dec->rend - r0) || dist > DEC_WIN_SIZE) return 0;
+
+            for (int k = 0; k < len; k++) {
+                uint8_t c = dec->win[(dec->wpos - dist) & (DEC_WIN_SIZE - 1)];
+                dec->win[dec->wpos++ & (DEC_WIN_SIZE - 1)] = c;
+                PutRaw(dec, c);
+            }
+        }
+    }
+    dec->crc = Crc32(dec->crctab, dec->crc, dec->raw + r0, dec->rend - r0);
+    dec->total += (uint32_t)(dec->rend - r0);
+
+    return 1;
+}
+
+// Read UNIX compress header and initialize LZW table (1: success, 0: failure)
+static int LzwHeader(decomp_t *dec)
+{
+    if (GetBits(dec, 16) != 0x9D1F) return 0;
+
+    int flags = (int)GetBits(dec, 8);
+    dec->maxbits = flags & 0x1F;
+    dec->blockMode = flags & 0x80;
+    if (dec->maxbits < 9 || dec->maxbits > LZW_MAX_BITS || OverBits(dec)) return 0;
+
+    dec->prefix = (uint16_t*)malloc((1 << LZW_MAX_BITS) * sizeof(uint16_t));
+    dec->suffix = (uint8_t*)malloc(1 << LZW_MAX_BITS);
+    dec->stack = (uint8_t*)malloc((1 << LZW_MAX_BITS) + 1);
+    if (!dec->prefix || !dec->suffix || !dec->stack) return 0;
+
+    for (int c = 0; c < 256; c++) {
+        dec->prefix[c] = 0;
+        dec->suffix[c] = (uint8_t)c;
+    }
+    dec->nbits = 9;
+    dec->maxcode = (dec->maxbits == 9) ? 1 << 9 : (1 << 9) - 1;
+    dec->freeEnt = dec->blockMode ? 257 : 256;
+    dec->oldcode = -1;
+    dec->finchar = 0;
+    dec->posbits = 0;
+
+    return 1;
+}
+
+// Skip LZW input to the end of current code group (code width change or CLEAR)
+//
+// Codes are written in groups of 8 codes (nbits bytes); the rest of the group
+// is discarded when the code width changes.
+static void LzwSkipGroup(decomp_t *dec)
+{
+    uint64_t group = (uint64_t)dec->nbits * 8;
+    uint64_t skip = (group - dec->posbits % group) % group;
+
+    for (; skip > 0; skip -= skip > 16 ? 16 : skip) GetBits(dec, skip > 16 ? 16 : (int)skip);
+    dec->posbits = 0;
+}
+
+// Decode LZW data into decoded byte buffer (1: success, 0: failure)
+static int UncompressRaw(decomp_t *dec)
+{
+    int maxmaxcode = 1 << dec->maxbits;
+
+    while (!dec->reof && DEC_RAW_SIZE - dec->rend > (1 << LZW_MAX_BITS)) {
+
+        // Increase code width when the table is full
+        if (dec->freeEnt > dec->maxcode) {
+            LzwSkipGroup(dec);
+            dec->nbits++;
+            dec->maxcode = (dec->nbits == dec->maxbits) ? maxmaxcode : (1 << dec->nbits) - 1;
+            continue;
+        }
+
+        // Read code (end of data if less than a code is left)
+        if (!NeedBits(dec, dec->nbits)) {
+            dec->reof = 1;
+            break;
+        }
+        int code = (int)GetBits(dec, dec->nbits);
+        dec->posbits += dec->nbits;
+
+        // First code
+        if (dec->oldcode == -1) {
+            if (code >= 256) return 0;
+            dec->finchar = dec->oldcode = code;
+            PutRaw(dec, code);
+            continue;
+        }
+
+        // Clear table
+        if (code == 256 && dec->blockMode) {
+            LzwSkipGroup(dec);
+            dec->freeEnt = 256;
+            dec->nbits = 9;
+            dec->maxcode = (dec->maxbits == 9) ? maxmaxcode : (1 << 9) - 1;
+            continue;
+        }
+
+        // Decode string onto stack (KwKwK case: code of entry being defined)
+        int incode = code;
+        uint8_t *sp = dec->stack + (1 << LZW_MAX_BITS) + 1;
+        if (code >= dec->freeEnt) {
+            if (code > dec->freeEnt) return 0;
+            *--sp = (uint8_t)dec->finchar;
+            code = dec->oldcode;
+        }
+        while (code >= 256) {
+            *--sp = dec->suffix[code];
+            code = dec->prefix[code];
+        }
+        *--sp = (uint8_t)(dec->finchar = dec->suffix[code]);
+
+        size_t n = (size_t)(dec->stack + (1 << LZW_MAX_BITS) + 1 - sp);
+        memcpy(dec->raw + dec->rend, sp, n);
+        dec->rend += n;
+
+        // Add table entry
+        if (dec->freeEnt < maxmaxcode) {
+            dec->prefix[dec->freeEnt] = (uint16_t)dec->oldcode;
+            dec->suffix[dec->freeEnt] = (uint8_t)dec->finchar;
+            dec->freeEnt++;
+        }
+        dec->oldcode = incode;
+    }
+    return 1;
+}
+
+// Fill decoded byte buffer (1: success, 0: failure)
+//
+// Unread bytes are moved to the front of the buffer first.
+static int FillRaw(decomp_t *dec)
+{
+    if (dec->rbeg > 0) {
+        memmove(dec->raw, dec->raw + dec->rbeg, dec->rend - dec->rbeg);
+        dec->rend -= dec->rbeg;
+        dec->rbeg = 0;
+    }
+    if (dec->reof) return 1;
+
+    int info = 1;
+    if (dec->type == DEC_GZIP) info = InflateRaw(dec);
+    else if (dec->type == DEC_LZW) info = UncompressRaw(dec);
+    else {
+        size_t n = ReadIn(dec, dec->raw + dec->rend, DEC_RAW_SIZE - dec->rend);
+        dec->rend += n;
+        if (n == 0) dec->reof = 1;
+    }
+    if (!info || dec->err) {
+        dec->err = 1;
+        return 0;
+    }
+    return 1;
+}
+
+// Get next line of decoded bytes ('\n' and trailing '\r' removed) (NULL: end or error)
+static char *GetRawLine(decomp_t *dec, int *len)
+{
+    while (1) {
+        uint8_t *p = dec->raw + dec->rbeg;
+        size_t n = dec->rend - dec->rbeg, l;
+        uint8_t *nl = (uint8_t*)memchr(p, '\n', n);
+
+        if (nl) {
+            l = (size_t)(nl - p);
+            dec->rbeg += l + 1;
+        }
+        else if (dec->reof) {
+            if (n == 0) return NULL;
+            l = n;                          // Last line without '\n'
+            dec->rbeg = dec->rend;
+        }
+        else {
+            if (n >= CRX_MAX_LINE) {
+                dec->err = 1;
+                return NULL;
+            }
+            if (!FillRaw(dec)) return NULL;
+            continue;
+        }
+        if (l >= CRX_MAX_LINE) {
+            dec->err = 1;
+            return NULL;
+        }
+        if (l > 0 && p[l - 1] == '\r') l--;
+        p[l] = '\0';
+        *len = (int)l;
+        return (char*)p;
+    }
+}
+
+// Reserve n bytes at end of restored text (NULL: failure)
+static char *TextSpace(decomp_t *dec, size_t n)
+{
+    if (dec->tbeg == dec->tend) dec->tbeg = dec->tend = 0;
+
+    if (dec->tend + n > dec->tcap) {
+        size_t cap = dec->tcap * 2;
+        while (cap < dec->tend + n) cap *= 2;
+        char *text = (char*)realloc(dec->text, cap);
+        if (!text) {
+            dec->err = 1;
+            return NULL;
+        }
+        dec->text = text;
+        dec->tcap = cap;
+    }
+    return dec->text + dec->tend;
+}
+
+// Put line to restored text (trailing blanks removed, '\n' added) (1: success, 0: failure)
+static int PutText(decomp_t *dec, const char *line, int len)
+{
+    while (len > 0 && line[len - 1] == ' ') len--;
+
+    char *p = TextSpace(dec, (size_t)len + 1);
+    if (!p) return 0;
+
+    memcpy(p, line, (size_t)len);
+    p[len] = '\n';
+    dec->tend += (size_t)len + 1;
+
+    return 1;
+}
+
+// Check if line has RINEX header label
+static int HasLabel(const char *line, int len, const char *label)
+{
+    int n = (int)strlen(label);
+    return len >= 60 + n && !memcmp(line + 60, label, (size_t)n);
+}
+
+// Parse unsigned integer field of line (-1: blank or invalid)
+static int LineInt(const char *line, int len, int pos, int width)
+{
+    int val = 0, digit = 0;
+
+    for (int i = pos; i < pos + width && i < len; i++) {
+        if (line[i] == ' ') continue;
+        if (line[i] < '0' || line[i] > '9') return -1;
+        val = val * 10 + (line[i] - '0');
+        digit = 1;
+    }
+    return digit ? val : -1;
+}
+
+// Apply text difference to line: ' ': unchanged, '&': blank, other: new character
+// (1: success, 0: line too long)
+static int RepairStr(char *str, size_t cap, const char *diff)
+{
+    size_t n = strlen(str), i;
+
+    for (i = 0; diff[i]; i++) {
+        if (i + 1 >= cap) return 0;
+        if (i >= n) str[i] = ' ';
+        if (diff[i] == '&') str[i] = ' ';
+        else if (diff[i] != ' ') str[i] = diff[i];
+    }
+    if (i > n) str[i] = '\0';
+
+    return 1;
+}
+
+// Decode differenced value of arc ("n&value": new arc of order n, "value": next
+// difference) and advance to its end (1: success, 0: failure)
+static int CrxValue(crxArc_t *arc, char **str)
+{
+    char *p = *str;
+
+    if (p[0] >= '0' && p[0] <= '9' && p[1] == '&') {
+        arc->arcOrder = p[0] - '0';
+        arc->order = 0;
+        p += 2;
+    }
+    else if (arc->order < 0) return 0;      // Arc not initialized
+    else if (arc->order < arc->arcOrder) arc->order++;
+
+    int neg = (*p == '-');
+    if (neg || *p == '+') p++;
+    if (*p < '0' || *p > '9') return 0;
+
+    int64_t val = 0;
+    for (int n = 0; *p >= '0' && *p <= '9'; p++, n++) {
+        if (n >= 18) return 0;              // Too many digits
+        val = val * 10 + (*p - '0');
+    }
+    if (*p != ' ' && *p != '\0') return 0;
+
+    // Restore value from k-th difference (wraps around on corrupted data)
+    arc->d[arc->order] = neg ? -val : val;
+    for (int k = arc->order; k > 0; k--) {
+        arc->d[k - 1] = (int64_t)((uint64_t)arc->d[k - 1] + (uint64_t)arc->d[k]);
+    }
+
+    *str = p;
+    return 1;
+}
+
+// Decode satellite data line of n observation types (1: success, 0: failure)
+//
+// Fields are separated by single blanks (a blank field is missing data) and
+// followed by the text difference of the LLI and SSI flags.
+static int CrxData(crxSat_t *sat, int n, char *line)
+{
+    char *s = line;
+
+    for (int j = 0; j < n; j++) {
+
+        // End of line: remaining fields missing, flags unchanged
+        if (*s == '\0') {
+            for (; j < n; j++) sat->arc[j].order = -1;
+            return 1;
+        }
+        if (*s == ' ') {
+            sat->arc[j].order = -1;
+            s++;
+            continue;
+        }
+        if (!CrxValue(&sat->arc[j], &s)) return 0;
+        if (*s == '\0') {
+            for (j++; j < n; j++) sat->arc[j].order = -1;
+            return 1;
+        }
+        s++;
+    }
+    return RepairStr(sat->flag, sizeof(sat->flag), s);
+}
+
+// Write fixed-point value in units of 10^-ndec right-aligned to width characters
+static void PutFixed(char *p, int width, int64_t val, int ndec)
+{
+    char tmp[32];
+    int n = 0;
+    uint64_t a = val < 0 ? (uint64_t)0 - (uint64_t)val : (uint64_t)val;
+
+    for (int k = 0; k < ndec; k++, a /= 10) tmp[n++] = (char)('0' + a % 10);
+    tmp[n++] = '.';
+    do {
+        tmp[n++] = (char)('0' + a % 10);
+        a /= 10;
+    } while (a > 0);
+    if (val < 0) tmp[n++] = '-';
+
+    if (n > width) {
+        memset(p, '*', (size_t)width);
+        return;
+    }
+    memset(p, ' ', (size_t)(width - n));
+    for (int k = 0; k < n; k++) p[width - 1 - k] = tmp[k];
+}
+
+// Write observation field (F14.3 value, LLI, SSI) of type j of satellite
+static void PutObsField(char *p, const crxSat_t *sat, int j)
+{
+    if (sat->arc[j].order >= 0) PutFixed(p, 14, sat->arc[j].d[0], 3);
+    else memset(p, ' ', 14);
+
+    size_t nflag = strlen(sat->flag);
+    p[14] = (size_t)(2 * j)     < nflag ? sat->flag[2 * j]     : ' ';
+    p[15] = (size_t)(2 * j + 1) < nflag ? sat->flag[2 * j + 1] : ' ';
+}
+
+// Get satellite state slot of satellite ID (NULL: invalid ID)
+static crxSat_t *CrxSat(decomp_t *dec, const char *id, int *sys)
+{
+    char c = (id[0] == ' ') ? 'G' : id[0];
+    const char *p = c ? strchr(CRX_SYS_STR, c) : NULL;
+    if (!p) return NULL;
+
+    int d1 = (id[1] == ' ') ? 0 : id[1] - '0', d2 = id[2] - '0';
+    if (d1 < 0 || d1 > 9 || d2 < 0 || d2 > 9) return NULL;
+
+    *sys = (int)(p - CRX_SYS_STR);
+    int i = *sys * 100 + d1 * 10 + d2;
+    if (!dec->sat[i]) {
+        if (!(dec->sat[i] = (crxSat_t*)calloc(1, sizeof(crxSat_t)))) return NULL;
+        dec->sat[i]->epoch = -2;
+    }
+    return dec->sat[i];
+}
+
+// Restore header line of compact RINEX (1: success, 0: end or failure)
+static int CrxHeader(decomp_t *dec)
+{
+    int len;
+    char *line = GetRawLine(dec, &len);
+    if (!line) {
+        dec->err = 1;
+        return 0;
+    }
+
+    // CRINEX lines are removed
+    if (dec->hdr == 0) {
+        if (HasLabel(line, len, "CRINEX PROG / DATE")) dec->hdr = 1;
+        return 1;
+    }
+
+    // Number of observation types (RINEX 3: per system, RINEX 2: all systems)
+    if (HasLabel(line, len, "SYS / # / OBS TYPES") && line[0] != ' ') {
+        const char *p = strchr(CRX_SYS_STR, line[0]);
+        int n = LineInt(line, len, 3, 3);
+        if (p && n >= 0) dec->ntype[p - CRX_SYS_STR] = n;
+    }
+    else if (HasLabel(line, len, "# / TYPES OF OBSERV")) {
+        int n = LineInt(line, len, 0, 6);
+        for (int i = 0; n >= 0 && i < CRX_NSYS; i++) dec->ntype[i] = n;
+    }
+    else if (HasLabel(line, len, "END OF HEADER")) {
+        dec->hdr = 2;
+    }
+    for (int i = 0; i < CRX_NSYS; i++) {
+        if (dec->ntype[i] > CRX_MAX_TYPE) dec->err = 1;
+    }
+
+    return !dec->err && PutText(dec, line, len);
+}
+
+// Restore epoch line of RINEX 2 (with continuation lines) or RINEX 3
+static int CrxEpochLine(decomp_t *dec, int nsat, int clk)
+{
+    char buff[128];
+
+    if (dec->crx == 3) {
+
+        // Epoch (cols 1-41) and receiver clock offset (F15.12)
+        memcpy(buff, dec->epoch, 41);
+        if (clk) PutFixed(buff + 41, 15, dec->clk.d[0], 12);
+        return PutText(dec, buff, clk ? 56 : 41);
+    }
+
+    // Epoch (cols 1-32), 12 satellites per line and receiver clock offset (F12.9)
+    for (int s = 0; s == 0 || s < nsat; s += 12) {
+        int n = (nsat - s < 12) ? nsat - s : 12;
+        if (s == 0) memcpy(buff, dec->epoch, 32);
+        else memset(buff, ' ', 32);
+        memcpy(buff + 32, dec->epoch + 32 + 3 * s, (size_t)(3 * n));
+        memset(buff + 32 + 3 * n, ' ', (size_t)(36 - 3 * n));
+        if (s == 0 && clk) PutFixed(buff + 68, 12, dec->clk.d[0], 9);
+        if (!PutText(dec, buff, (s == 0 && clk) ? 80 : 68)) return 0;
+    }
+    return 1;
+}
+
+// Restore epoch block of compact RINEX (1: success, 0: end or failure)
+static int CrxEpoch(decomp_t *dec)
+{
+    int len, v3 = (dec->crx == 3);
+    int flagPos = v3 ? 31 : 28, nsatPos = v3 ? 32 : 29, satPos = v3 ? 41 : 32;
+
+    // Epoch line: new ('&' or '>') or text difference from previous epoch line
+    // (blank lines are skipped)
+    char *line;
+    do {
+        if (!(line = GetRawLine(dec, &len))) return 0;
+    } while (len == 0);
+
+    if (line[0] == '&' || line[0] == '>') {
+        memcpy(dec->epoch, line, (size_t)len + 1);
+        if (!v3) dec->epoch[0] = ' ';
+    }
+    else if (!RepairStr(dec->epoch, sizeof(dec->epoch), line)) {
+        dec->err = 1;
+        return 0;
+    }
+    int elen = (int)strlen(dec->epoch);
+    int nsat = LineInt(dec->epoch, elen, nsatPos, 3);
+    if (elen <= flagPos || nsat < 0) {
+        dec->err = 1;
+        return 0;
+    }
+
+    // Special event: epoch line and header records as they are
+    char flag = dec->epoch[flagPos];
+    if (flag >= '2' && flag <= '5') {
+        if (!PutText(dec, dec->epoch, elen)) return 0;
+        for (int i = 0; i < nsat; i++) {
+            if (!(line = GetRawLine(dec, &len)) || !PutText(dec, line, len)) {
+                dec->err = 1;
+                return 0;
+            }
+        }
+        return 1;
+    }
+
+    // Satellite list (line is cut to the number of satellites)
+    if (satPos + 3 * nsat >= CRX_MAX_LINE || elen < satPos + 3 * nsat) {
+        dec->err = 1;
+        return 0;
+    }
+    dec->epoch[satPos + 3 * nsat] = '\0';
+
+    // Receiver clock offset line (blank: no clock offset)
+    if (!(line = GetRawLine(dec, &len))) {
+        dec->err = 1;
+        return 0;
+    }
+    if (len == 0) dec->clk.order = -1;
+    else if (!CrxValue(&dec->clk, &line)) {
+        dec->err = 1;
+        return 0;
+    }
+    if (!CrxEpochLine(dec, nsat, dec->clk.order >= 0)) return 0;
+    dec->nep++;
+
+    // Satellite data lines
+    for (int s = 0; s < nsat; s++) {
+        const char *id = dec->epoch + satPos + 3 * s;
+        int sys;
+        crxSat_t *sat = CrxSat(dec, id, &sys);
+        if (!sat || !(line = GetRawLine(dec, &len))) {
+            dec->err = 1;
+            return 0;
+        }
+
+        // Arcs and flags continue only from the previous epoch
+        int n = dec->ntype[sys];
+        if (sat->epoch != dec->nep - 1) {
+            for (int j = 0; j < CRX_MAX_TYPE; j++) sat->arc[j].order = -1;
+            sat->flag[0] = '\0';
+        }
+        sat->epoch = dec->nep;
+
+        if (!CrxData(sat, n, line)) {
+            dec->err = 1;
+            return 0;
+        }
+
+        // RINEX 3: satellite ID and fields, RINEX 2: 5 fields per line
+        char buff[3 + 16 * CRX_MAX_TYPE];
+        if (v3) {
+            memcpy(buff, id, 3);
+            for (int j = 0; j < n; j++) PutObsField(buff + 3 + 16 * j, sat, j);
+            if (!PutText(dec, buff, 3 + 16 * n)) return 0;
+        }
+        else {
+            for (int j = 0; j == 0 || j < n; j += 5) {
+                int k = 0;
+                for (; k < 5 && j + k < n; k++) PutObsField(buff + 16 * k, sat, j + k);
+                if (!PutText(dec, buff, 16 * k)) return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// Detect byte format of data (DEC_PLAIN, DEC_GZIP, DEC_LZW)
+static int ByteType(const uint8_t *data, size_t size)
+{
+    if (size >= 2 && data[0] == 0x1F && data[1] == 0x8B) return DEC_GZIP;
+    if (size >= 2 && data[0] == 0x1F && data[1] == 0x9D) return DEC_LZW;
+    return DEC_PLAIN;
+}
+
+// Detect compact RINEX version of text (0: not compact RINEX)
+static int CrxType(const uint8_t *data, size_t size)
+{
+    const uint8_t *nl = (const uint8_t*)memchr(data, '\n', size);
+    size_t len = nl ? (size_t)(nl - data) : size;
+    size_t n = strlen(CRX_LABEL);
+
+    if (len < 60 + n || memcmp(data + 60, CRX_LABEL, n)) return 0;
+
+    // CRINEX version (F9.1)
+    for (size_t i = 0; i < 9; i++) {
+        if (data[i] == ' ') continue;
+        return (data[i] == '1') ? 1 : (data[i] == '3') ? 3 : -1;
+    }
+    return -1;
+}
+
+// Start decompression stream after input is set (1: success, 0: failure)
+static int StartDecomp(decomp_t *dec)
+{
+    // CRC-32 table
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+        dec->crctab[n] = c;
+    }
+
+    // Byte format
+    if (dec->ipos >= dec->isize) FillIn(dec);
+    dec->type = ByteType(dec->in + dec->ipos, dec->isize - dec->ipos);
+
+    if (!(dec->raw = (uint8_t*)malloc(DEC_RAW_SIZE + 1))) return 0;
+    if (dec->type == DEC_GZIP) {
+        if (!(dec->win = (uint8_t*)malloc(DEC_WIN_SIZE)) || !GzipHeader(dec)) return 0;
+    }
+    else if (dec->type == DEC_LZW) {
+        if (!LzwHeader(dec)) return 0;
+    }
+
+    // Compact RINEX (first line of decoded bytes)
+    while (!dec->reof && dec->rend < 81) {
+        if (!FillRaw(dec)) return 0;
+    }
+    dec->crx = CrxType(dec->raw, dec->rend);
+    if (dec->crx < 0) return 0;
+    if (dec->crx) {
+        dec->tcap = DEC_RAW_SIZE;
+        if (!(dec->text = (char*)malloc(dec->tcap))) return 0;
+    }
+    return !dec->err;
+}
+
+// Allocate decompression stream
+static decomp_t *NewDecomp(void)
+{
+    decomp_t *dec = (decomp_t*)calloc(1, sizeof(decomp_t));
+    if (!dec) return NULL;
+
+    dec->block = -1;
+    dec->clk.order = -1;
+
+    return dec;
+}
+
+// =============================================================================
+// Decompression functions
+// =============================================================================
+
+// Open file for decompressed reading
+decomp_t *OpenDecomp(const char *filename)
+{
+    if (!filename) return NULL;
+
+    decomp_t *dec = NewDecomp();
+    if (!dec) return NULL;
+
+    dec->fp = fopen(filename, "rb");
+    dec->ibuf = (uint8_t*)malloc(DEC_IN_SIZE);
+    dec->in = dec->ibuf;
+
+    if (!dec->fp || !dec->ibuf || !StartDecomp(dec)) {
+        CloseDecomp(dec);
+        return NULL;
+    }
+    return dec;
+}
+
+// Read decompressed data
+size_t ReadDecomp(decomp_t *dec, void *buff, size_t size)
+{
+    if (!dec || !buff) return 0;
+
+    uint8_t *out = (uint8_t*)buff;
+    size_t n = 0;
+
+    while (n < size && !dec->err) {
+
+        // Restored RINEX text of compact RINEX
+        if (dec->crx) {
+            if (dec->tbeg == dec->tend) {
+                int info = (dec->hdr < 2) ? CrxHeader(dec) : CrxEpoch(dec);
+                if (!info) break;
+                continue;
+            }
+            size_t k = dec->tend - dec->tbeg;
+            if (k > size - n) k = size - n;
+            memcpy(out + n, dec->text + dec->tbeg, k);
+            dec->tbeg += k;
+            n += k;
+            continue;
+        }
+
+        // Decoded bytes
+        if (dec->rbeg == dec->rend) {
+            if (dec->reof) break;
+
+            // Plain bytes are read directly
+            if (dec->type == DEC_PLAIN) {
+                size_t k = ReadIn(dec, out + n, size - n);
+                if (k == 0) dec->reof = 1;
+                n += k;
+                continue;
+            }
+            if (!FillRaw(dec)) break;
+            continue;
+        }
+        size_t k = dec->rend - dec->rbeg;
+        if (k > size - n) k = size - n;
+        memcpy(out + n, dec->raw + dec->rbeg, k);
+        dec->rbeg += k;
+        n += k;
+    }
+    return n;
+}
+
+// Check decompression error
+int ErrorDecomp(const decomp_t *dec)
+{
+    return !dec || dec->err;
+}
+
+// Resume reading after end of data
+int ResumeDecomp(decomp_t *dec)
+{
+    if (!dec || dec->err || dec->type != DEC_PLAIN || dec->crx) return 0;
+
+    if (dec->fp) clearerr(dec->fp);
+    dec->ieof = 0;
+    dec->reof = 0;
+
+    return 1;
+}
+
+// Close decompression stream
+void CloseDecomp(decomp_t *dec)
+{
+    if (!dec) return;
+
+    if (dec->fp) fclose(dec->fp);
+    free(dec->ibuf);
+    free(dec->raw);
+    free(dec->win);
+    free(dec->prefix);
+    free(dec->suffix);
+    free(dec->stack);
+    free(dec->text);
+    for (int i = 0; i < CRX_MAX_SAT; i++) free(dec->sat[i]);
+    free(dec);
+}
+
+// Decompress file buffer in memory
+int DecompBuff(buffer_t *buffer)
+{
+    if (!buffer || !buffer->buff) return 0;
+
+    // Check if the data is compressed or compact RINEX
+    const uint8_t *data = (const uint8_t*)buffer->buff;
+    if (ByteType(data, buffer->size) == DEC_PLAIN && CrxType(data, buffer->size) == 0) {
+        return 1;
+    }
+
+    // Decompress from memory
+    decomp_t *dec = NewDecomp();
+    if (!dec) return 0;
+    dec->in = data;
+    dec->isize = buffer->size;
+    dec->ieof = 1;
+
+    size_t cap = buffer->size * 4 + DEC_RAW_SIZE, n = 0;
+    char *out = (char*)malloc(cap + 1);
+    int info = out && StartDecomp(dec);
+
+    while (info) {
+        if (cap - n < DEC_RAW_SIZE) {
+            char *buff = (char*)realloc(out, cap * 2 + 1);
+            if (!buff) {
+                info = 0;
+                break;
+            }
+            out = buff;
+            cap *= 2;
+        }
+        size_t want = cap - n;
+        size_t k = ReadDecomp(dec, out + n, want);
+        n += k;
+        if (k < want) break;
+    }
+    if (ErrorDecomp(dec)) info = 0;
+    CloseDecomp(dec);
+
+    if (!info) {
+        free(out);
+        return 0;
+    }
+
+    // Replace the buffer by the decompressed text
+    out[n] = '\0';
+    FreeBuff(buffer);
+    buffer->buff = out;
+    buffer->size = n;
+    buffer->map = 0;
+
+    return 1;
+}
+
+// =============================================================================
+// End of file
+// =============================================================================
@@ -5,10 +5,20 @@
 // Yongrae Jo, 0727ggame@sju.ac.kr
 // =============================================================================
 
+// Feature test macro (POSIX posix_memalign with strict C99)
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 // Standard library
 #include <stddef.h>                     // for NULL
 #include <math.h>                       // for sqrt, sin, cos, atan2, fabs
-#include <stdlib.h>                     // for realloc, free
+#include <stdlib.h>                     // for realloc, free, qsort, posix_memalign
+#include <float.h>                      // for DBL_MAX
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>                  // for AVX2 intrinsics
+#define EPHEMERIS_SIMD_X86              // Vectorized Keplerian orbit kernel available
+#endif
 
 // GNSS library
 #include "ephemeris.h"
@@ -28,6 +38,15 @@
 
 #define TOL_KEPLER      1E-13                   // Tolerance for Kepler's equation
 
+#define DT_EPHCACHE     1E-3                    // Margin of ephemeris selection cache interval (s)
+
+#define PREP_ALIGNMENT  64                      // Memory alignment of prepared ephemeris (cache line)
+
+#define FOPI            1.27323954473516268615  // 4/pi
+#define PIO4_1          7.85398125648498535156E-1   // pi/4 split into 3 parts
+#define PIO4_2          3.77489470793079817668E-8   // (extended precision reduction)
+#define PIO4_3          2.69515142907905952645E-15
+
 // =============================================================================
 // Static variables
 // =============================================================================
@@ -35,6 +54,9 @@
 // Broadcast ephemeris type
 static int EPHTYPE[NSYS] = {0};
 
+// Satellite velocity and clock drift type (0: analytic, 1: central difference)
+static int VELTYPE = 0;
+
 // URA error value
 static const double URA_ERR[] = {
       2.40,    3.40,    4.85,    6.85,    9.65,
@@ -45,20 +67,28 @@ static const double URA_ERR[] = {
 // Number of URA error values
 static const int NURA = sizeof(URA_ERR) / sizeof(URA_ERR[0]);
 
+#ifdef EPHEMERIS_SIMD_X86
+// Polynomial coefficients of sine and cosine in [-pi/4, pi/4] (Cephes)
+static const double SIN_COF[] = {
+     1.58962301576546568060E-10, -2.50507477628578072866E-8,
+     2.75573136213857245213E-6,  -1.98412698295895385996E-4,
+     8.33333333332211858878E-3,  -1.66666666666666307295E-1,
+};
+static const double COS_COF[] = {
+    -1.13585365213876817300E-11,  2.08757008419747316778E-9,
+    -2.75573141792967388112E-7,   2.48015872888517045348E-5,
+    -1.38888888888730564116E-3,   4.16666666666665929218E-2,
+};
+#endif
+
 // =============================================================================
 // Static functions
 // =============================================================================
 
-// Compute satellite position and clock bias using kepler parameters (1:ok, 0:error)
-static int Eph2Pos(double time, const eph_t *eph, double *pos, double *clk, double *var)
+// Prepare Keplerian ephemeris constants of broadcast ephemeris data (1:ok, 0:error)
+static int PrepEph(const eph_t *eph, ephPrep_t *prep)
 {
-    // Initialize output
-    if (pos) {pos[0] = pos[1] = pos[2] = 0.0;}
-    if (clk) {*clk = 0.0;}
-    if (var) {*var = 0.0;}
-
-    // Check if the broadcast ephemeris data is valid
-    if (!eph) return 0;
+    *prep = (ephPrep_t){.valid = 0};
 
     // Check ephemeris validity
     if (eph->A <= 0.0) return 0;
@@ -79,11 +109,70 @@ static int Eph2Pos(double time, const eph_t *eph, double *pos, double *clk, doub
         default: return 0;
     }
 
+    // Check if BeiDou GEO satellite
+    prep->geo = (Sys2Str(sys) == STR_BDS && (prn <= 5 || prn >= 59)) ? 1 : 0;
+
+    // Mean motion, eccentricity and relativistic terms
+    prep->n     = sqrt(mu / (eph->A * eph->A * eph->A)) + eph->deln;
+    prep->sqrte = sqrt(1.0 - eph->e * eph->e);
+    prep->frel  = 2.0 * sqrt(mu * eph->A) * eph->e;
+
+    // Longitude of ascending node terms
+    prep->OMGd  = prep->geo ? eph->OMGd : eph->OMGd - omge;
+    prep->OMGt  = omge * eph->toes;
+    prep->omge  = omge;
+
+    // URA value (GAL: SISA value)
+    prep->ura   = (Sys2Str(sys) == STR_GAL) ? Idx2Sisa(eph->sva) : Idx2Ura(eph->sva);
+    prep->valid = 1;
+
+    return 1;
+}
+
+// Velocity of Keplerian satellite position from orbital plane position (xp, yp),
+// its rate (xpd, ypd), inclination rate ikd and longitude of ascending node rate
+// omgd
+static void KepVel(double xp, double yp, double xpd, double ypd, double sinik,
+                   double cosik, double ikd, double sinomgk, double cosomgk, double omgd,
+                   double *vel)
+{
+    double x = xp * cosomgk - yp * cosik * sinomgk;
+    double y = xp * sinomgk + yp * cosik * cosomgk;
+
+    vel[0] = xpd * cosomgk - ypd * cosik * sinomgk + yp * sinik * sinomgk * ikd - y * omgd;
+    vel[1] = xpd * sinomgk + ypd * cosik * cosomgk - yp * sinik * cosomgk * ikd + x * omgd;
+    vel[2] = ypd * sinik + yp * cosik * ikd;
+}
+
+// Compute satellite position, velocity, clock bias and drift using kepler
+// parameters (1:ok, 0:error) (prepared ephemeris constants are computed if prep
+// is NULL)
+static int Eph2Pos(double time, const eph_t *eph, const ephPrep_t *prep, double *pos,
+                   double *vel, double *clk, double *dclk, double *var)
+{
+    // Initialize output
+    if (pos ) {pos[0] = pos[1] = pos[2] = 0.0;}
+    if (vel ) {vel[0] = vel[1] = vel[2] = 0.0;}
+    if (clk ) {*clk = 0.0;}
+    if (dclk) {*dclk = 0.0;}
+    if (var ) {*var = 0.0;}
+
+    // Check if the broadcast ephemeris data is valid
+    if (!eph) return 0;
+
+    // Prepare Keplerian ephemeris constants
+    ephPrep_t prep0;
+    if (!prep) {
+        PrepEph(eph, &prep0);
+        prep = &prep0;
+    }
+    if (!prep->valid) return 0;
+
     // Time from ephemeris reference epoch
     double tk = time - eph->toe;
 
     // Mean anomaly
-    double Mk = eph->M0 + (sqrt(mu / (eph->A * eph->A * eph->A)) + eph->deln) * tk;
+    double Mk = eph->M0 + prep->n * tk;
 
     // Kepler's equation (by newton-raphson method)
     double Ek0 = 0.0, Ek = Mk;
@@ -100,8 +189,11 @@ static int Eph2Pos(double time, const eph_t *eph, double *pos, double *clk, doub
     double sinEk = sin(Ek);
     double cosEk = cos(Ek);
 
+    // Rate of eccentric anomaly
+    double Ekd = prep->n / (1.0 - eph->e * cosEk);
+
     // Argument of latitude, radius and inclination
-    double uk = atan2(sqrt(1.0 - eph->e * eph->e) * sinEk, cosEk - eph->e) + eph->omg;
+    double uk = atan2(prep->sqrte * sinEk, cosEk - eph->e) + eph->omg;
     double rk = eph->A * (1.0 - eph->e * cosEk);
     double ik = eph->i0 + eph->iodt * tk;
 
@@ -114,19 +206,32 @@ static int Eph2Pos(double time, const eph_t *eph, double *pos, double *clk, doub
     ik += eph->cis * sin2uk + eph->cic * cos2uk;
 
     // Satellite positions in orbital plane
-    double xkp = rk * cos(uk);
-    double ykp = rk * sin(uk);
+    double cosuk = cos(uk);
+    double sinuk = sin(uk);
+    double xkp = rk * cosuk;
+    double ykp = rk * sinuk;
 
     // Trigonometric functions for inclination
     double sinik = sin(ik);
     double cosik = cos(ik);
 
+    // Rates of argument of latitude, radius, inclination and orbital plane positions
+    double xkpd = 0.0, ykpd = 0.0, ikd = 0.0;
+    if (vel) {
+        double phid = prep->sqrte * Ekd / (1.0 - eph->e * cosEk);
+        double ukd = phid * (1.0 + 2.0 * (eph->cus * cos2uk - eph->cuc * sin2uk));
+        double rkd = eph->A * eph->e * sinEk * Ekd + 2.0 * phid * (eph->crs * cos2uk - eph->crc * sin2uk);
+        ikd  = eph->iodt + 2.0 * phid * (eph->cis * cos2uk - eph->cic * sin2uk);
+        xkpd = rkd * cosuk - ykp * ukd;
+        ykpd = rkd * sinuk + xkp * ukd;
+    }
+
     // Check if BeiDou GEO satellite
-    if (Sys2Str(sys) == STR_BDS && (prn <= 5 || prn >= 59)) {
+    if (prep->geo) {
         // BeiDou GEO satellite coordinate transformation
 
         // Correct longitude of ascending node
-        double omgk = eph->OMG0 + eph->OMGd * tk - omge * eph->toes;
+        double omgk = eph->OMG0 + prep->OMGd * tk - prep->OMGt;
         double sinomgk = sin(omgk);
         double cosomgk = cos(omgk);
 
@@ -136,8 +241,8 @@ static int Eph2Pos(double time, const eph_t *eph, double *pos, double *clk, doub
         double zgk = ykp * sinik;
 
         // Earth rotation during signal transmission
-        double sinok = sin(omge * tk);
-        double cosok = cos(omge * tk);
+        double sinok = sin(prep->omge * tk);
+        double cosok = cos(prep->omge * tk);
 
         // Transform to ECEF coordinates
         if (pos) {
@@ -145,12 +250,26 @@ static int Eph2Pos(double time, const eph_t *eph, double *pos, double *clk, doub
             pos[1] = -xgk * sinok + ygk * cosok * COS_5 + zgk * cosok * SIN_5;
             pos[2] = -ygk * SIN_5 + zgk * COS_5;
         }
+
+        // Velocity by rotation rate of intermediate frame
+        if (vel) {
+            double velg[3];
+            KepVel(xkp, ykp, xkpd, ykpd, sinik, cosik, ikd, sinomgk, cosomgk, prep->OMGd, velg);
+
+            double xr =  xgk * cosok + ygk * sinok * COS_5 + zgk * sinok * SIN_5;
+            double yr = -xgk * sinok + ygk * cosok * COS_5 + zgk * cosok * SIN_5;
+            double yd = velg[1] * COS_5 + velg[2] * SIN_5;
+
+            vel[0] =  velg[0] * cosok + yd * sinok + prep->omge * yr;
+            vel[1] = -velg[0] * sinok + yd * cosok - prep->omge * xr;
+            vel[2] = -velg[1] * SIN_5 + velg[2] * COS_5;
+        }
     }
     else {
         // Standard satellite coordinate transformation
 
         // Correct longitude of ascending node
-        double omgk = eph->OMG0 + (eph->OMGd - omge) * tk - omge * eph->toes;
+        double omgk = eph->OMG0 + prep->OMGd * tk - prep->OMGt;
         double sinomgk = sin(omgk);
         double cosomgk = cos(omgk);
 
@@ -160,6 +279,11 @@ static int Eph2Pos(double time, const eph_t *eph, double *pos, double *clk, doub
             pos[1] = xkp * sinomgk + ykp * cosik * cosomgk;
             pos[2] = ykp * sinik;
         }
+
+        // Velocity in ECEF coordinates
+        if (vel) {
+            KepVel(xkp, ykp, xkpd, ykpd, sinik, cosik, ikd, sinomgk, cosomgk, prep->OMGd, vel);
+        }
     }
 
     // Satellite clock bias correction
@@ -171,12 +295,19 @@ static int Eph2Pos(double time, const eph_t *eph, double *pos, double *clk, doub
         *clk = eph->af0 + eph->af1 * tk + eph->af2 * tk * tk;
 
         // Relativistic correction
-        *clk -= 2.0 * sqrt(mu * eph->A) * eph->e * sinEk / SQR(C_LIGHT);
+        *clk -= prep->frel * sinEk / SQR(C_LIGHT);
+    }
+
+    // Satellite clock drift
+    if (dclk) {
+        double tk = time - eph->toc;
+
+        *dclk = eph->af1 + 2.0 * eph->af2 * tk - prep->frel * cosEk * Ekd / SQR(C_LIGHT);
     }
 
     // Position and clock error variance
     if (var) {
-        *var = Idx2Ura(eph->sva);
+        *var = prep->ura;
         if (*var < 0.0) return 0;
 
         *var = SQR(*var);
@@ -242,20 +373,24 @@ static void GloRK4(double dt, double *x, const double *acc)
     }
 }
 
-// Compute satellite position and clock bias of GLONASS satellite (1:ok, 0:error)
-static int GloEph2Pos(double time, const eph_t *eph, double *pos, double *clk, double *var)
+// Compute satellite position, velocity, clock bias and drift of GLONASS satellite
+// (1:ok, 0:error)
+static int GloEph2Pos(double time, const eph_t *eph, double *pos, double *vel, double *clk,
+                      double *dclk, double *var)
 {
     // Initialize output
-    if (pos) {pos[0] = pos[1] = pos[2] = 0.0;}
-    if (clk) {*clk = 0.0;}
-    if (var) {*var = 0.0;}
+    if (pos ) {pos[0] = pos[1] = pos[2] = 0.0;}
+    if (vel ) {vel[0] = vel[1] = vel[2] = 0.0;}
+    if (clk ) {*clk = 0.0;}
+    if (dclk) {*dclk = 0.0;}
+    if (var ) {*var = 0.0;}
 
     // Check if the GLONASS ephemeris data is valid
     if (!eph) return 0;
 
     // Check if the satellite system is GLONASS
     int sys = Sat2Prn(eph->sat, NULL);
-    if (sys != STR_GLO) return 0;
+    if (sys <= 0 || sys > NSYS || Sys2Str(sys) != STR_GLO) return 0;
 
     // Time from ephemeris reference epoch
     double tk = time - eph->toe;
@@ -282,12 +417,22 @@ static int GloEph2Pos(double time, const eph_t *eph, double *pos, double *clk, d
         for (int i = 0; i < 3; i++) pos[i] = x[i];
     }
 
+    // Set satellite velocity (integrated state)
+    if (vel) {
+        for (int i = 0; i < 3; i++) vel[i] = x[i+3];
+    }
+
     // Satellite clock bias correction
     if (clk) {
         // GLONASS clock model: tau_n - gamma_n * (t - t_c)
         *clk = -eph->taun + eph->gamn * (time - eph->toc);
     }
 
+    // Satellite clock drift
+    if (dclk) {
+        *dclk = eph->gamn;
+    }
+
     // Position and clock error variance
     if (var) {
         *var = SQR(STD_EPH_GLO);
@@ -297,13 +442,17 @@ static int GloEph2Pos(double time, const eph_t *eph, double *pos, double *clk, d
     return 1;
 }
 
-// Compute satellite position and clock bias of SBAS satellite (1:ok, 0:error)
-static int SbsEph2Pos(double time, const eph_t *eph, double *pos, double *clk, double *var)
+// Compute satellite position, velocity, clock bias and drift of SBAS satellite
+// (1:ok, 0:error)
+static int SbsEph2Pos(double time, const eph_t *eph, double *pos, double *vel, double *clk,
+                      double *dclk, double *var)
 {
     // Initialize output
-    if (pos) {pos[0] = pos[1] = pos[2] = 0.0;}
-    if (clk) {*clk = 0.0;}
-    if (var) {*var = 0.0;}
+    if (pos ) {pos[0] = pos[1] = pos[2] = 0.0;}
+    if (vel ) {vel[0] = vel[1] = vel[2] = 0.0;}
+    if (clk ) {*clk = 0.0;}
+    if (dclk) {*dclk = 0.0;}
+    if (var ) {*var = 0.0;}
 
     // Time from ephemeris reference epoch
     double tk = time - eph->toe;
@@ -315,11 +464,23 @@ static int SbsEph2Pos(double time, const eph_t *eph, double *pos, double *clk, d
         }
     }
 
+    // Satellite velocity
+    if (vel) {
+        for (int i = 0; i < 3; i++) {
+            vel[i] = eph->vel[i] + eph->acc[i] * tk;
+        }
+    }
+
     // Satellite clock bias correction
     if (clk) {
         *clk = eph->af0 + eph->af1 * tk;
     }
 
+    // Satellite clock drift
+    if (dclk) {
+        *dclk = eph->af1;
+    }
+
     // Position and clock error variance
     if (var) {
         *var = Idx2Ura(eph->sva);
@@ -347,6 +508,33 @@ static int ResizeEphs(ephs_t *ephs, int nnew)
     return 1;
 }
 
+// Compare ephemeris index keys by the order of time transmission and index
+static int CompareEphKey(const void *a, const void *b)
+{
+    const ephKey_t *key1 = (const ephKey_t *)a;
+    const ephKey_t *key2 = (const ephKey_t *)b;
+
+    if (key1->ttr != key2->ttr) return (key1->ttr > key2->ttr) ? 1 : -1;
+    return key1->i - key2->i;
+}
+
+// Ephemeris source of ephemeris data set index for satellite system
+// (0: default or GAL I/NAV, 1: GAL F/NAV)
+static int EphSrc(int sys)
+{
+    return (Sys2Str(sys) == STR_GAL && GetEphType(sys) == 1) ? 1 : 0;
+}
+
+// Check if ephemeris data is from ephemeris source
+static int IsEphSrc(const eph_t *eph, int sys, int src)
+{
+    // Galileo: I/NAV or F/NAV data source bit
+    if (Sys2Str(sys) == STR_GAL) return (eph->data & (src == 1 ? 1<<8 : 1<<9)) != 0;
+
+    // Others: default source only
+    return src == 0;
+}
+
 // Compare ephemeris data by the order of satellite index and time transmission
 // (eph.ttr)
 static int CompareEph(const void *a, const void *b)
@@ -361,6 +549,429 @@ static int CompareEph(const void *a, const void *b)
     return (eph1->ttr > eph2->ttr) ? 1 : -1;
 }
 
+// Resize prepared ephemeris array with cache line alignment (not shrunk, contents
+// are not kept)
+static int ResizePrep(ephs_t *ephs, int n)
+{
+    if (n <= ephs->nprep) return 1;
+
+    // Free old prepared ephemeris
+#ifdef _WIN32
+    if (ephs->prep) _aligned_free(ephs->prep);
+#else
+    if (ephs->prep) free(ephs->prep);
+#endif
+    ephs->prep = NULL;
+    ephs->nprep = 0;
+
+    // Allocate new prepared ephemeris
+    size_t tsize = (size_t)n * sizeof(ephPrep_t);
+#ifdef _WIN32
+    ephs->prep = (ephPrep_t *)_aligned_malloc(tsize, PREP_ALIGNMENT);
+    if (!ephs->prep) return 0;
+#else
+    if (posix_memalign((void **)&ephs->prep, PREP_ALIGNMENT, tsize) != 0) {
+        ephs->prep = NULL;
+        return 0;
+    }
+#endif
+    ephs->nprep = n;
+
+    return 1;
+}
+
+// Compute satellite position, velocity, clock bias and drift by satellite system
+// (1:ok, 0:error) (prep: prepared Keplerian ephemeris or NULL)
+static int EphPosClk(int sys, double time, const eph_t *eph, const ephPrep_t *prep,
+                     double *pos, double *vel, double *clk, double *dclk, double *var)
+{
+    switch (Sys2Str(sys)) {
+        case STR_GPS:
+        case STR_GAL:
+        case STR_BDS:
+        case STR_QZS:
+        case STR_IRN: return Eph2Pos   (time, eph, prep, pos, vel, clk, dclk, var);
+        case STR_GLO: return GloEph2Pos(time, eph,       pos, vel, clk, dclk, var);
+        case STR_SBS: return SbsEph2Pos(time, eph,       pos, vel, clk, dclk, var);
+        default: return 0;
+    }
+}
+
+// Select broadcast ephemeris data by time index (same result as linear search of
+// SelectEph)
+//
+// The latest ephemeris with ttr <= ephtime that passes the IODE and toe checks
+// is searched backward from the binary search position. Among equal ttr
+// distances, the first ephemeris data in the set is selected. The search stops
+// when all preceding toe are older than maxdtoe.
+static eph_t *SelectEphIdx(const ephs_t *ephs, double ephtime, int sat, int iode, int src,
+                           double maxdtoe)
+{
+    const ephKey_t *key = ephs->key[src];
+
+    // Number of keys with ttr <= ephtime (binary search)
+    int lo = 0, hi = ephs->nkey[src];
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (key[mid].ttr > ephtime) hi = mid;
+        else lo = mid + 1;
+    }
+
+    // Search backward for closest ttr ephemeris data
+    int    idx  = -1;
+    double dttr = 0.0;
+    for (int j = lo - 1; j >= 0; j--) {
+
+        // No preceding ephemeris data within maximum difference of Toe
+        if (ephtime - key[j].toemax > maxdtoe) break;
+
+        // Farther ttr than the selected one
+        if (idx >= 0 && fabs(key[j].ttr - ephtime) != dttr) break;
+
+        const eph_t *eph = ephs->eph + key[j].i;
+
+        // Check if the satellite index and IODE are valid
+        if (eph->sat != sat) continue;
+        if (iode >= 0 && eph->IODE != iode) continue;
+
+        // Calculate difference between Toe and ephemeris time
+        if (fabs(ephtime - eph->toe) > maxdtoe) continue;
+
+        if (idx < 0 || key[j].i < idx) {
+            idx  = key[j].i;
+            dttr = fabs(key[j].ttr - ephtime);
+        }
+    }
+
+    // Return selected ephemeris data
+    if (idx < 0) return NULL;
+    return ephs->eph + idx;
+}
+
+// Set ephemeris selection cache of ephemeris data selected by time index
+//
+// The validity interval [tmin, tmax) holds the ephemeris times for which the
+// selection does not change, as long as the selected ephemeris data itself
+// passes the ttr and toe checks. It ends at the next transmission time and is
+// narrowed by the toe of the other ephemeris data with ttr close to or later
+// than the selected one, which may pass the toe check at another time.
+static void SetEphCache(const ephs_t *ephs, ephCache_t *cache, double ephtime, int iode,
+                        int src, double maxdtoe, int idx)
+{
+    const ephKey_t *key = ephs->key[src];
+    double ttr = ephs->eph[idx].ttr;
+
+    cache->idx = -1;
+
+    // Number of keys with ttr <= ephtime (binary search)
+    int lo = 0, hi = ephs->nkey[src];
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (key[mid].ttr > ephtime) hi = mid;
+        else lo = mid + 1;
+    }
+
+    // Until next transmission time
+    double tmin = ttr;
+    double tmax = (lo < ephs->nkey[src]) ? key[lo].ttr : DBL_MAX;
+
+    // Other ephemeris data from the margin before selected ttr to ephemeris time
+    for (int j = lo - 1; j >= 0 && key[j].ttr >= ttr - DT_EPHCACHE; j--) {
+        if (key[j].i == idx) continue;
+
+        // Close but different ttr (ttr differences may be rounded to the same)
+        if (key[j].ttr != ttr && fabs(key[j].ttr - ttr) < DT_EPHCACHE) return;
+
+        // Later or earlier ephemeris time passing the toe check
+        double toe = ephs->eph[key[j].i].toe;
+        if (toe - ephtime > maxdtoe) {
+            if (tmax > toe - maxdtoe - DT_EPHCACHE) tmax = toe - maxdtoe - DT_EPHCACHE;
+        }
+        else if (ephtime - toe > maxdtoe) {
+            if (tmin < toe + maxdtoe + DT_EPHCACHE) tmin = toe + maxdtoe + DT_EPHCACHE;
+        }
+    }
+    if (ephtime < tmin || ephtime >= tmax) return;
+
+    // Update cache
+    cache->idx   = idx;
+    cache->iode  = iode;
+    cache->stamp = ephs->stamp;
+    cache->tmin  = tmin;
+    cache->tmax  = tmax;
+}
+
+// Prepared Keplerian ephemeris of selected ephemeris data if the ephemeris data
+// set is indexed (NULL if not)
+static const ephPrep_t *SelectPrep(const nav_t *nav, int sat, const eph_t *eph)
+{
+    const ephs_t *ephs = nav->ephs + sat - 1;
+
+    if (ephs->nidx < 0 || ephs->nidx != ephs->n || !ephs->prep) return NULL;
+    return ephs->prep + (eph - ephs->eph);
+}
+
+// Compute satellite position, velocity, clock bias and drift by satellite system
+// with velocity and clock drift type of SetVelType (1:ok, 0:error) (prep:
+// prepared Keplerian ephemeris or NULL)
+static int EphPosClkVel(int sys, double time, const eph_t *eph, const ephPrep_t *prep,
+                        double *pos, double *vel, double *clk, double *dclk, double *var)
+{
+    // Analytic velocity and clock drift
+    if (VELTYPE == 0) return EphPosClk(sys, time, eph, prep, pos, vel, clk, dclk, var);
+
+    // Central difference of position and clock bias (prepared once)
+    ephPrep_t prep0;
+    if (!prep) {
+        PrepEph(eph, &prep0);
+        prep = &prep0;
+    }
+    double posf[3], posb[3], clkf, clkb, tt = 1E-3;
+    if (!EphPosClk(sys, time     , eph, prep, pos , NULL, clk  , NULL, var )) return 0;
+    if (!EphPosClk(sys, time + tt, eph, prep, posf, NULL, &clkf, NULL, NULL)) return 0;
+    if (!EphPosClk(sys, time - tt, eph, prep, posb, NULL, &clkb, NULL, NULL)) return 0;
+
+    // Time difference as rounded in the standard time (not exactly 2 * tt)
+    double dt = (time + tt) - (time - tt);
+
+    for (int i = 0; i < 3; i++) vel[i] = (posf[i] - posb[i]) / dt;
+    *dclk = (clkf - clkb) / dt;
+
+    return 1;
+}
+
+// Set i-th satellite of batch output (zeros if stat = 0)
+static void SetPosClks(satPosClks_t *out, int i, int stat, const double *pos,
+                       const double *vel, double clk, double dclk, double var)
+{
+    for (int k = 0; k < 3; k++) {
+        if (out->pos[k]) out->pos[k][i] = stat ? pos[k] : 0.0;
+        if (out->vel[k]) out->vel[k][i] = stat ? vel[k] : 0.0;
+    }
+    if (out->dts ) out->dts [i] = stat ? clk  : 0.0;
+    if (out->ddts) out->ddts[i] = stat ? dclk : 0.0;
+    if (out->var ) out->var [i] = stat ? var  : 0.0;
+    if (out->stat) out->stat[i] = stat;
+}
+
+#ifdef EPHEMERIS_SIMD_X86
+// Sine and cosine of 4 angles by AVX2 (Cephes polynomials in the octant reduced
+// angle, accurate for |x| < 1E8 rad)
+__attribute__((target("avx2")))
+static inline void SinCosAvx2(__m256d x, __m256d *s, __m256d *c)
+{
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d one  = _mm256_set1_pd(1.0);
+    const __m256i two  = _mm256_set1_epi64x(2);
+    const __m256i four = _mm256_set1_epi64x(4);
+
+    // Even octant y and reduced angle z = |x| - y * pi/4 (|z| <= pi/4)
+    __m256d ax = _mm256_andnot_pd(sign, x);
+    __m256d y  = _mm256_floor_pd(_mm256_mul_pd(ax, _mm256_set1_pd(FOPI)));
+    y = _mm256_floor_pd(_mm256_mul_pd(_mm256_add_pd(y, one), _mm256_set1_pd(0.5)));
+    y = _mm256_add_pd(y, y);
+
+    __m256d z = _mm256_sub_pd(ax, _mm256_mul_pd(y, _mm256_set1_pd(PIO4_1)));
+    z = _mm256_sub_pd(z, _mm256_mul_pd(y, _mm256_set1_pd(PIO4_2)));
+    z = _mm256_sub_pd(z, _mm256_mul_pd(y, _mm256_set1_pd(PIO4_3)));
+
+    // Octant index j = y mod 8 (0, 2, 4, 6) from mantissa of y + 2^52
+    __m256i j = _mm256_castpd_si256(_mm256_add_pd(y, _mm256_set1_pd(4503599627370496.0)));
+    j = _mm256_and_si256(j, _mm256_set1_epi64x(7));
+
+    // Sine and cosine polynomials of reduced angle
+    __m256d zz = _mm256_mul_pd(z, z);
+    __m256d ps = _mm256_set1_pd(SIN_COF[0]);
+    __m256d pc = _mm256_set1_pd(COS_COF[0]);
+    for (int k = 1; k < 6; k++) {
+        ps = _mm256_add_pd(_mm256_mul_pd(ps, zz), _mm256_set1_pd(SIN_COF[k]));
+        pc = _mm256_add_pd(_mm256_mul_pd(pc, zz), _mm256_set1_pd(COS_COF[k]));
+    }
+    ps = _mm256_add_pd(z, _mm256_mul_pd(_mm256_mul_pd(z, zz), ps));
+    pc = _mm256_add_pd(_mm256_sub_pd(one, _mm256_mul_pd(zz, _mm256_set1_pd(0.5))),
+                       _mm256_mul_pd(_mm256_mul_pd(zz, zz), pc));
+
+    // Swap sine and cosine in octants 2 and 6, negate sine in octants 4 and 6
+    // (and for x < 0) and cosine in octants 2 and 4
+    __m256d swap = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(j, two), two));
+    __m256d ssgn = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(j, four), 61));
+    __m256d csgn = _mm256_castsi256_pd(_mm256_slli_epi64(
+                   _mm256_and_si256(_mm256_add_epi64(j, two), four), 61));
+    ssgn = _mm256_xor_pd(ssgn, _mm256_and_pd(x, sign));
+
+    *s = _mm256_xor_pd(_mm256_blendv_pd(ps, pc, swap), ssgn);
+    *c = _mm256_xor_pd(_mm256_blendv_pd(pc, ps, swap), csgn);
+}
+
+// Compute satellite positions, velocities, clock biases and drifts of 4 Keplerian
+// satellites (not BeiDou GEO) by AVX2 (stat: 1:ok, 0:not converged)
+//
+// Same model as Eph2Pos. The true anomaly is not computed: the sine and cosine of
+// the argument of latitude are derived from those of the eccentric anomaly and
+// the argument of perigee by angle addition, so all trigonometric functions are
+// evaluated by SinCosAvx2.
+__attribute__((target("avx2")))
+static void Eph2PosAvx2(const double *time, const eph_t *const *eph,
+                        const ephPrep_t *const *prep, double pos[3][4], double vel[3][4],
+                        double *clk, double *dclk, int *stat)
+{
+#define LANES(p, f) _mm256_set_pd((p)[3]->f, (p)[2]->f, (p)[1]->f, (p)[0]->f)
+#define ADD(a, b)   _mm256_add_pd(a, b)
+#define SUB(a, b)   _mm256_sub_pd(a, b)
+#define MUL(a, b)   _mm256_mul_pd(a, b)
+#define DIV(a, b)   _mm256_div_pd(a, b)
+
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d one  = _mm256_set1_pd(1.0);
+    const __m256d two  = _mm256_set1_pd(2.0);
+    const __m256d tol  = _mm256_set1_pd(TOL_KEPLER);
+
+    __m256d t     = _mm256_loadu_pd(time);
+    __m256d e     = LANES(eph, e);
+    __m256d A     = LANES(eph, A);
+    __m256d n     = LANES(prep, n);
+    __m256d sqrte = LANES(prep, sqrte);
+
+    // Time from ephemeris reference epoch and mean anomaly
+    __m256d tk = SUB(t, LANES(eph, toe));
+    __m256d Mk = ADD(LANES(eph, M0), MUL(n, tk));
+
+    // Kepler's equation (by newton-raphson method, converged lanes are kept)
+    // (converged within MAX_ITER_KEPLER - 1 iterations as Eph2Pos)
+    __m256d Ek = Mk, sinEk, cosEk;
+    __m256d conv = _mm256_cmp_pd(_mm256_andnot_pd(sign, Mk), tol, _CMP_LE_OQ);
+    for (int iter = 0; iter < MAX_ITER_KEPLER - 1 && _mm256_movemask_pd(conv) != 0xF; iter++) {
+        SinCosAvx2(Ek, &sinEk, &cosEk);
+        __m256d Ek1 = SUB(Ek, DIV(SUB(SUB(Ek, MUL(e, sinEk)), Mk), SUB(one, MUL(e, cosEk))));
+        __m256d dEk = _mm256_andnot_pd(sign, SUB(Ek1, Ek));
+        Ek   = _mm256_blendv_pd(Ek1, Ek, conv);
+        conv = _mm256_or_pd(conv, _mm256_cmp_pd(dEk, tol, _CMP_LE_OQ));
+    }
+    SinCosAvx2(Ek, &sinEk, &cosEk);
+
+    // Rate of eccentric anomaly
+    __m256d den = SUB(one, MUL(e, cosEk));
+    __m256d Ekd = DIV(n, den);
+
+    // Argument of latitude by true anomaly and argument of perigee
+    __m256d sinvk = DIV(MUL(sqrte, sinEk), den);
+    __m256d cosvk = DIV(SUB(cosEk, e), den);
+    __m256d sinw, cosw;
+    SinCosAvx2(LANES(eph, omg), &sinw, &cosw);
+    __m256d sinuk = ADD(MUL(sinvk, cosw), MUL(cosvk, sinw));
+    __m256d cosuk = SUB(MUL(cosvk, cosw), MUL(sinvk, sinw));
+
+    // Correct argument of latitude, radius and inclination
+    __m256d sin2uk = MUL(two, MUL(sinuk, cosuk));
+    __m256d cos2uk = MUL(SUB(cosuk, sinuk), ADD(cosuk, sinuk));
+    __m256d cus = LANES(eph, cus), cuc = LANES(eph, cuc);
+    __m256d crs = LANES(eph, crs), crc = LANES(eph, crc);
+    __m256d cis = LANES(eph, cis), cic = LANES(eph, cic);
+    __m256d iodt = LANES(eph, iodt);
+
+    __m256d duk = ADD(MUL(cus, sin2uk), MUL(cuc, cos2uk));
+    __m256d rk  = ADD(MUL(A, den), ADD(MUL(crs, sin2uk), MUL(crc, cos2uk)));
+    __m256d ik  = ADD(ADD(LANES(eph, i0), MUL(iodt, tk)), ADD(MUL(cis, sin2uk), MUL(cic, cos2uk)));
+
+    __m256d sinduk, cosduk;
+    SinCosAvx2(duk, &sinduk, &cosduk);
+    __m256d sinu = ADD(MUL(sinuk, cosduk), MUL(cosuk, sinduk));
+    __m256d cosu = SUB(MUL(cosuk, cosduk), MUL(sinuk, sinduk));
+
+    // Satellite positions in orbital plane
+    __m256d xkp = MUL(rk, cosu);
+    __m256d ykp = MUL(rk, sinu);
+
+    // Trigonometric functions for inclination
+    __m256d sinik, cosik;
+    SinCosAvx2(ik, &sinik, &cosik);
+
+    // Correct longitude of ascending node
+    __m256d OMGd = LANES(prep, OMGd);
+    __m256d omgk = SUB(ADD(LANES(eph, OMG0), MUL(OMGd, tk)), LANES(prep, OMGt));
+    __m256d sinomgk, cosomgk;
+    SinCosAvx2(omgk, &sinomgk, &cosomgk);
+
+    // Transform to ECEF coordinates
+    __m256d x = SUB(MUL(xkp, cosomgk), MUL(MUL(ykp, cosik), sinomgk));
+    __m256d y = ADD(MUL(xkp, sinomgk), MUL(MUL(ykp, cosik), cosomgk));
+    __m256d z = MUL(ykp, sinik);
+
+    // Rates of argument of latitude, radius, inclination and orbital plane positions
+    __m256d phid = DIV(MUL(sqrte, Ekd), den);
+    __m256d ukd  = MUL(phid, ADD(one, MUL(two, SUB(MUL(cus, cos2uk), MUL(cuc, sin2uk)))));
+    __m256d rkd  = ADD(MUL(MUL(MUL(A, e), sinEk), Ekd),
+                       MUL(MUL(two, phid), SUB(MUL(crs, cos2uk), MUL(crc, sin2uk))));
+    __m256d ikd  = ADD(iodt, MUL(MUL(two, phid), SUB(MUL(cis, cos2uk), MUL(cic, sin2uk))));
+    __m256d xkpd = SUB(MUL(rkd, cosu), MUL(ykp, ukd));
+    __m256d ykpd = ADD(MUL(rkd, sinu), MUL(xkp, ukd));
+
+    // Velocity in ECEF coordinates (as KepVel)
+    __m256d vx = ADD(SUB(MUL(xkpd, cosomgk), MUL(MUL(ykpd, cosik), sinomgk)),
+                     SUB(MUL(MUL(MUL(ykp, sinik), sinomgk), ikd), MUL(y, OMGd)));
+    __m256d vy = ADD(SUB(ADD(MUL(xkpd, sinomgk), MUL(MUL(ykpd, cosik), cosomgk)),
+                         MUL(MUL(MUL(ykp, sinik), cosomgk), ikd)), MUL(x, OMGd));
+    __m256d vz = ADD(MUL(ykpd, sinik), MUL(MUL(ykp, cosik), ikd));
+
+    // Satellite clock bias and drift with relativistic correction
+    __m256d tc   = SUB(t, LANES(eph, toc));
+    __m256d af1  = LANES(eph, af1), af2 = LANES(eph, af2);
+    __m256d frel = DIV(LANES(prep, frel), _mm256_set1_pd(SQR(C_LIGHT)));
+    __m256d dts  = ADD(LANES(eph, af0), MUL(ADD(af1, MUL(af2, tc)), tc));
+    __m256d ddts = ADD(af1, MUL(MUL(two, af2), tc));
+    dts  = SUB(dts , MUL(frel, sinEk));
+    ddts = SUB(ddts, MUL(MUL(frel, cosEk), Ekd));
+
+    // Store lanes
+    _mm256_storeu_pd(pos[0], x);
+    _mm256_storeu_pd(pos[1], y);
+    _mm256_storeu_pd(pos[2], z);
+    _mm256_storeu_pd(vel[0], vx);
+    _mm256_storeu_pd(vel[1], vy);
+    _mm256_storeu_pd(vel[2], vz);
+    _mm256_storeu_pd(clk , dts );
+    _mm256_storeu_pd(dclk, ddts);
+
+    int mask = _mm256_movemask_pd(conv);
+    for (int k = 0; k < 4; k++) stat[k] = (mask >> k) & 1;
+
+#undef LANES
+#undef ADD
+#undef SUB
+#undef MUL
+#undef DIV
+}
+
+// Compute and set Keplerian satellites of batch lane group by AVX2 (nlane <= 4,
+// unused lanes are filled with the first lane) (return: number of satellites
+// computed)
+static int SatPosClkLanes(satPosClks_t *out, int nlane, const int *idx, double *time,
+                          const eph_t **eph, const ephPrep_t **prep)
+{
+    for (int k = nlane; k < 4; k++) {
+        time[k] = time[0];
+        eph [k] = eph [0];
+        prep[k] = prep[0];
+    }
+    double pos[3][4], vel[3][4], clk[4], dclk[4];
+    int stat[4];
+    Eph2PosAvx2(time, eph, prep, pos, vel, clk, dclk, stat);
+
+    int nok = 0;
+    for (int k = 0; k < nlane; k++) {
+        double posk[3] = {pos[0][k], pos[1][k], pos[2][k]};
+        double velk[3] = {vel[0][k], vel[1][k], vel[2][k]};
+
+        // Position and clock error variance
+        if (prep[k]->ura < 0.0) stat[k] = 0;
+
+        SetPosClks(out, idx[k], stat[k], posk, velk, clk[k], dclk[k], SQR(prep[k]->ura));
+        nok += stat[k];
+    }
+    return nok;
+}
+#endif
+
 // =============================================================================
 // Ephemeris data structure functions
 // =============================================================================
@@ -375,6 +986,18 @@ void InitEphs(ephs_t *ephs)
     ephs->n = 0;
     ephs->nmax = 0;
     ephs->eph = NULL;
+
+    // Initialize the time index
+    ephs->nidx = -1;
+    for (int k = 0; k < NEPHSRC; k++) {
+        ephs->nkey[k] = 0;
+        ephs->key[k] = NULL;
+    }
+    ephs->stamp = 0;
+
+    // Initialize the prepared ephemeris
+    ephs->nprep = 0;
+    ephs->prep = NULL;
 }
 
 // Free ephemeris data set structure
@@ -389,6 +1012,24 @@ void FreeEphs(ephs_t *ephs)
         ephs->eph = NULL;
     }
     ephs->n = ephs->nmax = 0;
+
+    // Free the time index
+    for (int k = 0; k < NEPHSRC; k++) {
+        free(ephs->key[k]);
+        ephs->key[k] = NULL;
+        ephs->nkey[k] = 0;
+    }
+    ephs->nidx = -1;
+    ephs->stamp++;
+
+    // Free the prepared ephemeris
+#ifdef _WIN32
+    if (ephs->prep) _aligned_free(ephs->prep);
+#else
+    if (ephs->prep) free(ephs->prep);
+#endif
+    ephs->prep = NULL;
+    ephs->nprep = 0;
 }
 
 // Add ephemeris data to ephemeris data set structure
@@ -403,13 +1044,26 @@ int AddEph(ephs_t *ephs, const eph_t *eph)
         if (!ResizeEphs(ephs, nnew)) return 0;
     }
 
-    // Add the ephemeris data to the ephemeris data set
+    // Add the ephemeris data to the ephemeris data set (time index is outdated)
     ephs->eph[ephs->n] = *eph;
     ephs->n++;
+    ephs->nidx = -1;
 
     return 1;
 }
 
+// Reserve memory of ephemeris data set structure
+int ReserveEphs(ephs_t *ephs, int n)
+{
+    // Check if the ephemeris data set structure is valid
+    if (!ephs || n < 0) return 0;
+
+    // Resize only if the memory is not enough
+    if (n <= ephs->nmax) return 1;
+
+    return ResizeEphs(ephs, n);
+}
+
 // Sort ephemeris data set by the order of satellite index and time transmission
 // (eph.ttr)
 void SortEphs(ephs_t *ephs)
@@ -442,6 +1096,57 @@ void SortEphs(ephs_t *ephs)
 
     // Update the number of ephemeris data
     ephs->n = n;
+
+    // Build time index
+    IndexEphs(ephs);
+}
+
+// Build time index of ephemeris data set
+int IndexEphs(ephs_t *ephs)
+{
+    // Check if the ephemeris data set structure is valid
+    if (!ephs) return 0;
+
+    // Outdate time index and selection caches
+    ephs->nidx = -1;
+    ephs->stamp++;
+
+    for (int k = 0; k < NEPHSRC; k++) {
+
+        // Allocate index keys of all ephemeris data
+        ephKey_t *key = (ephKey_t *)realloc(ephs->key[k], (ephs->n > 0 ? ephs->n : 1) * sizeof(ephKey_t));
+        if (!key) return 0;
+        ephs->key[k] = key;
+
+        // Keys of ephemeris data from the ephemeris source
+        int n = 0;
+        for (int i = 0; i < ephs->n; i++) {
+            const eph_t *eph = ephs->eph + i;
+            int sys = Sat2Prn(eph->sat, NULL);
+            if (sys <= 0 || sys > NSYS || !IsEphSrc(eph, sys, k)) continue;
+
+            key[n].ttr = eph->ttr;
+            key[n].toemax = eph->toe;
+            key[n].i = i;
+            n++;
+        }
+
+        // Sort keys by time transmission and set running maximum of toe
+        qsort(key, n, sizeof(ephKey_t), CompareEphKey);
+        for (int j = 1; j < n; j++) {
+            if (key[j].toemax < key[j-1].toemax) key[j].toemax = key[j-1].toemax;
+        }
+        ephs->nkey[k] = n;
+    }
+
+    // Prepare Keplerian ephemeris constants of all ephemeris data
+    if (!ResizePrep(ephs, ephs->n > 0 ? ephs->n : 1)) return 0;
+    for (int i = 0; i < ephs->n; i++) {
+        PrepEph(ephs->eph + i, ephs->prep + i);
+    }
+    ephs->nidx = ephs->n;
+
+    return 1;
 }
 
 // =============================================================================
@@ -449,6 +1154,21 @@ void SortEphs(ephs_t *ephs)
 // =============================================================================
 
 // Get broadcast ephemeris type
+int GetVelType(void)
+{
+    // Return satellite velocity and clock drift type
+    return VELTYPE;
+}
+
+void SetVelType(int type)
+{
+    // Check if the satellite velocity and clock drift type is valid
+    if (type < 0 || type > 1) return;
+
+    // Set satellite velocity and clock drift type
+    VELTYPE = type;
+}
+
 int GetEphType(int sys)
 {
     if (sys < 1 || sys > NSYS) return -1;
@@ -572,8 +1292,27 @@ int TestEph(const eph_t *eph)
     return 1;
 }
 
+// Initialize ephemeris selection cache
+void InitEphSel(ephSel_t *sel)
+{
+    // Check if the ephemeris selection cache is valid
+    if (!sel) return;
+
+    for (int i = 0; i < NSAT; i++) {
+        for (int k = 0; k < NEPHSRC; k++) {
+            sel->cache[i][k] = (ephCache_t){.idx = -1, .iode = -1};
+        }
+    }
+}
+
 // Select broadcast ephemeris data
 eph_t *SelectEph(double ephtime, int sat, const nav_t *nav, int iode)
+{
+    return SelectEphSel(ephtime, sat, nav, iode, NULL);
+}
+
+// Select broadcast ephemeris data with ephemeris selection cache
+eph_t *SelectEphSel(double ephtime, int sat, const nav_t *nav, int iode, ephSel_t *sel)
 {
     // Check if the ephemeris time is valid
     if (ephtime < 0.0) return NULL;
@@ -598,6 +1337,25 @@ eph_t *SelectEph(double ephtime, int sat, const nav_t *nav, int iode)
         default: return NULL;
     }
 
+    // Select broadcast ephemeris data by time index if it is up to date
+    const ephs_t *ephs = nav->ephs + sat - 1;
+    if (ephs->nidx >= 0 && ephs->nidx == ephs->n) {
+        int src = EphSrc(sys);
+        if (!sel) return SelectEphIdx(ephs, ephtime, sat, iode, src, maxdtoe);
+
+        // Cached selection of the same index within the validity interval
+        ephCache_t *cache = sel->cache[sat - 1] + src;
+        if (cache->idx >= 0 && cache->idx < ephs->n && cache->stamp == ephs->stamp &&
+            cache->iode == iode && ephtime >= cache->tmin && ephtime < cache->tmax) {
+            eph_t *eph = ephs->eph + cache->idx;
+            if (eph->ttr <= ephtime && fabs(ephtime - eph->toe) <= maxdtoe) return eph;
+        }
+
+        eph_t *eph = SelectEphIdx(ephs, ephtime, sat, iode, src, maxdtoe);
+        if (eph) SetEphCache(ephs, cache, ephtime, iode, src, maxdtoe, (int)(eph - ephs->eph));
+        return eph;
+    }
+
     // Select broadcast ephemeris data
     int    idx  = -1;
     double dttr = 0.0;
@@ -646,6 +1404,14 @@ eph_t *SelectEph(double ephtime, int sat, const nav_t *nav, int iode)
 // ephemeris data
 int SatPosClkBrdc(double ephtime, double time, int sat, const nav_t *nav,
 int iode, mat_t *rs, mat_t *dts, double *var, eph_t *eph)
+{
+    return SatPosClkBrdcSel(ephtime, time, sat, nav, iode, NULL, rs, dts, var, eph);
+}
+
+// Compute satellite position, velocity, and clock bias/drift using broadcast
+// ephemeris data with ephemeris selection cache
+int SatPosClkBrdcSel(double ephtime, double time, int sat, const nav_t *nav,
+int iode, ephSel_t *sel, mat_t *rs, mat_t *dts, double *var, eph_t *eph)
 {
     // Check matrix dimensions
     if (rs ) {if ( rs->rows != 1 ||  rs->cols != 6) return 0;}
@@ -668,48 +1434,26 @@ int iode, mat_t *rs, mat_t *dts, double *var, eph_t *eph)
     if (ephtime < 0.0 || time < 0.0) return 0;
 
     // Select broadcast ephemeris data
-    eph_t *ephSelected = SelectEph(ephtime, sat, nav, iode);
+    eph_t *ephSelected = SelectEphSel(ephtime, sat, nav, iode, sel);
     if (!ephSelected) return 0;
 
-    // Compute satellite position and clock bias
-    double pos0[3], posf[3], posb[3], clk0, clkf, clkb, var0, tt = 1E-3;
+    // Prepared ephemeris of indexed ephemeris data set
+    const ephPrep_t *prep = SelectPrep(nav, sat, ephSelected);
 
-    switch (Sys2Str(sys)) {
-        case STR_GPS:
-        case STR_GAL:
-        case STR_BDS:
-        case STR_QZS:
-        case STR_IRN: {
-            if (!Eph2Pos(time     , ephSelected, pos0, &clk0, &var0)) return 0;
-            if (!Eph2Pos(time + tt, ephSelected, posf, &clkf, NULL )) return 0;
-            if (!Eph2Pos(time - tt, ephSelected, posb, &clkb, NULL )) return 0;
-        } break;
-
-        case STR_GLO: {
-            if (!GloEph2Pos(time     , ephSelected, pos0, &clk0, &var0)) return 0;
-            if (!GloEph2Pos(time + tt, ephSelected, posf, &clkf, NULL )) return 0;
-            if (!GloEph2Pos(time - tt, ephSelected, posb, &clkb, NULL )) return 0;
-        } break;
-
-        case STR_SBS: {
-            if (!SbsEph2Pos(time     , ephSelected, pos0, &clk0, &var0)) return 0;
-            if (!SbsEph2Pos(time + tt, ephSelected, posf, &clkf, NULL )) return 0;
-            if (!SbsEph2Pos(time - tt, ephSelected, posb, &clkb, NULL )) return 0;
-        } break;
-
-        default: return 0;
-    }
+    // Compute satellite position, velocity, clock bias and drift
+    double pos0[3], vel0[3], clk0, dclk0, var0;
+    if (!EphPosClkVel(sys, time, ephSelected, prep, pos0, vel0, &clk0, &dclk0, &var0)) return 0;
 
     // Set satellite position and velocity
     if (rs) {
-        for (int i = 0; i < 3; i++) MatSetD(rs, 0, i, pos0[i]);
-        for (int i = 3; i < 6; i++) MatSetD(rs, 0, i, (posf[i-3] - posb[i-3]) / (2.0 * tt));
+        for (int i = 0; i < 3; i++) MatSetD(rs, 0, i  , pos0[i]);
+        for (int i = 0; i < 3; i++) MatSetD(rs, 0, i+3, vel0[i]);
     }
 
     // Set satellite clock bias and drift
     if (dts) {
         MatSetD(dts, 0, 0, clk0);
-        MatSetD(dts, 0, 1, (clkf - clkb) / (2.0 * tt));
+        MatSetD(dts, 0, 1, dclk0);
     }
 
     // Set variance of position and clock bias
@@ -722,6 +1466,84 @@ int iode, mat_t *rs, mat_t *dts, double *var, eph_t *eph)
     return 1;
 }
 
+// Compute satellite positions, velocities, and clock biases/drifts of multiple
+// satellites using broadcast ephemeris data
+int SatPosClkBrdcBatch(int n, const double *ephtime, const double *time, const int *sat,
+                       const int *iode, const nav_t *nav, ephSel_t *sel, satPosClks_t *out)
+{
+    double pos[3] = {0}, vel[3] = {0}, clk = 0.0, dclk = 0.0, var = 0.0;
+
+    // Check output and input data
+    if (!out) return 0;
+    if (!nav || !sat || !time) {
+        for (int i = 0; i < n; i++) SetPosClks(out, i, 0, pos, vel, clk, dclk, var);
+        return 0;
+    }
+
+    // Keplerian satellite lane group (SIMD)
+#ifdef EPHEMERIS_SIMD_X86
+    int simd = (VELTYPE == 0 && __builtin_cpu_supports("avx2")) ? 1 : 0;
+    int idx[4], nlane = 0;
+    double timel[4];
+    const eph_t *ephl[4];
+    const ephPrep_t *prepl[4];
+    ephPrep_t prep0[4];
+#endif
+
+    int nok = 0;
+    for (int i = 0; i < n; i++) {
+        // Check satellite system and times
+        int sys = Sat2Prn(sat[i], NULL);
+        double ephtimei = ephtime ? ephtime[i] : time[i];
+        if (sys <= 0 || sys > NSYS || ephtimei < 0.0 || time[i] < 0.0) {
+            SetPosClks(out, i, 0, pos, vel, clk, dclk, var);
+            continue;
+        }
+
+        // Select broadcast ephemeris data
+        const eph_t *eph = SelectEphSel(ephtimei, sat[i], nav, iode ? iode[i] : -1, sel);
+        if (!eph) {
+            SetPosClks(out, i, 0, pos, vel, clk, dclk, var);
+            continue;
+        }
+        const ephPrep_t *prep = SelectPrep(nav, sat[i], eph);
+
+#ifdef EPHEMERIS_SIMD_X86
+        // Add Keplerian satellite (not BeiDou GEO) to lane group
+        if (simd) {
+            if (!prep) {
+                PrepEph(eph, prep0 + nlane);
+                prep = prep0 + nlane;
+            }
+            if (prep->valid && !prep->geo) {
+                idx  [nlane] = i;
+                timel[nlane] = time[i];
+                ephl [nlane] = eph;
+                prepl[nlane] = prep;
+                if (++nlane == 4) {
+                    nok += SatPosClkLanes(out, nlane, idx, timel, ephl, prepl);
+                    nlane = 0;
+                }
+                continue;
+            }
+        }
+#endif
+
+        // Compute satellite position, velocity, clock bias and drift (scalar)
+        int stat = EphPosClkVel(sys, time[i], eph, prep, pos, vel, &clk, &dclk, &var);
+        SetPosClks(out, i, stat, pos, vel, clk, dclk, var);
+        nok += stat;
+    }
+
+#ifdef EPHEMERIS_SIMD_X86
+    // Remaining lane group
+    if (nlane > 0) nok += SatPosClkLanes(out, nlane, idx, timel, ephl, prepl);
+#endif
+
+    // Return number of satellites computed
+    return nok;
+}
+
 // =============================================================================
 // End of file
 // =============================================================================
@@ -7,20 +7,97 @@
 
 // Standard library
 #include <stdlib.h>                     // for malloc, free, realloc
-#include <string.h>                     // for strlen, strcpy
-#include <stdio.h>                      // for fopen, fseek, ftell, fread, fclose
+#include <string.h>                     // for strlen, strcpy, memchr, memcpy, memcmp
+#include <stdio.h>                      // for fopen, fseek, ftell, fread, fclose, rename
+#include <stdint.h>                     // for uint32_t, uint64_t
+#include <limits.h>                     // for INT_MAX
+#include <sys/stat.h>                   // for stat, fstat
+#ifndef _WIN32
+#include <sys/mman.h>                   // for mmap, munmap, madvise
+#include <fcntl.h>                      // for open
+#include <unistd.h>                     // for close, sysconf
+#include <pthread.h>                    // for pthread_create, pthread_join, pthread_mutex_t
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>                  // for AVX2 intrinsics
+#define FILES_SIMD_X86                  // Vectorized line indexer available
+#endif
 
 // GNSS library
 #include "files.h"
 #include "rinex.h"                      // for IsRinexObs, ReadRnxObs, ReadRnxNav
-#include "obs.h"                        // for SortObss
-#include "ephemeris.h"                  // for SortEphs
+#include "obs.h"                        // for ReserveObss, SortObss
+#include "ephemeris.h"                  // for AddEph, ReserveEphs, SortEphs, IndexEphs
+#include "common.h"                     // for InitNav, FreeNav, GetFcn, SetFcn
+#include "decomp.h"                     // for DecompBuff
 
 // =============================================================================
 // Macros
 // =============================================================================
 
 #define MAX_FILE_NAME_LEN 1024          // Maximum number of characters in file name
+#define LINE_LEN_HINT     64            // Expected line length for initial line table size
+#define MAX_FILE_THREAD   64            // Maximum number of file reading threads
+#define CACHE_ALIGN       64            // Alignment of cache file records [bytes]
+#define OBS_CACHE_EXT     ".obc"        // Observation cache file extension
+#define OBS_CACHE_MAGIC   "GNSSOBC"     // Observation cache file magic string
+#define OBS_CACHE_VER     1             // Observation cache format version
+#define NAV_CACHE_MAGIC   "GNSSNBC"     // Navigation cache file magic string
+#define NAV_CACHE_VER     1             // Navigation cache format version
+
+// =============================================================================
+// Static type definitions
+// =============================================================================
+
+typedef struct obsCacheHead {               // Observation cache file header (little-endian)
+    char     magic[8];                      // Magic string (OBS_CACHE_MAGIC)
+    uint32_t ver;                           // Format version (OBS_CACHE_VER)
+    uint32_t sizeObs;                       // Size of observation data record [bytes]
+    uint64_t stamp;                         // Source file and read filter stamp
+    uint64_t n;                             // Number of observation data records
+    sta_t    sta;                           // Station information
+} obsCacheHead_t;
+
+typedef struct navCacheHead {               // Navigation cache file header (little-endian)
+    char     magic[8];                      // Magic string (NAV_CACHE_MAGIC)
+    uint32_t ver;                           // Format version (NAV_CACHE_VER)
+    uint32_t sizeEph;                       // Size of ephemeris data record [bytes]
+    uint64_t stamp;                         // Source files stamp
+    uint64_t n;                             // Number of ephemeris data records
+    int32_t  neph[NSAT];                    // Number of ephemeris data records per satellite
+    int32_t  fcn[NSAT_GLO + 1];             // GLONASS FCN by PRN - MIN_PRN_GLO (-99: unset)
+    double   iono[NSYS][8];                 // Broadcast ionosphere model parameters
+} navCacheHead_t;
+
+#ifndef _WIN32
+typedef struct filePool {                   // File reading worker pool (internal)
+    void            (*func)(void *, int);   // Task function (argument, task index)
+    void            *arg;                   // Task function argument
+    int             ntask;                  // Number of tasks
+    int             next;                   // Next task index
+    pthread_mutex_t lock;                   // Lock of next task index
+} filePool_t;
+
+typedef struct obsFile {                    // Observation file read in parallel (internal)
+    const char *filename;                   // File name
+    obss_t     obs;                         // Private observation data (receiver index 1)
+    sta_t      sta;                         // Station information
+    opt_t      *opt;                        // Processing options (read filter)
+    int        info;                        // Read result (1: success, 0: failure)
+} obsFile_t;
+
+typedef struct navFile {                    // Navigation file read in parallel (internal)
+    const char *filename;                   // File name
+    nav_t      nav;                         // Private navigation data
+    int        info;                        // Read result (1: success, 0: failure)
+} navFile_t;
+
+typedef struct navMerge {                   // Per-satellite navigation merge (internal)
+    nav_t     *nav;                         // Navigation data to merge into
+    navFile_t *file;                        // Navigation files in file order
+    int       nfile;                        // Number of navigation files
+} navMerge_t;
+#endif
 
 // =============================================================================
 // Static functions (internal use only)
@@ -87,6 +164,442 @@ static int ResizeFileStr(files_t *files, int nnew)
     return 1;
 }
 
+// Read whole file into heap buffer (internal) (1: success, 0: failure)
+static int ReadBuff(const char *filename, buffer_t *buffer)
+{
+    // Open the file
+    FILE *fp = fopen(filename, "rb");
+    if (!fp) return 0;
+
+    // Get file size
+    fseek(fp, 0, SEEK_END);
+    long fsize = ftell(fp);
+    rewind(fp);
+    if (fsize < 0) {
+        fclose(fp);
+        return 0;
+    }
+    size_t size = (size_t)fsize;
+
+    // Allocate memory for the buffer
+    char *buff = (char*)malloc(size + 1);
+    if (!buff) {
+        fclose(fp);
+        return 0;
+    }
+
+    // Read the file into the buffer
+    size_t nread = fread(buff, 1, size, fp);
+    fclose(fp);
+    if (nread != size) {
+        free(buff);
+        return 0;
+    }
+
+    // Null terminate the buffer
+    buff[size] = '\0';
+
+    buffer->buff = buff;
+    buffer->size = size;
+    buffer->map = 0;
+
+    return 1;
+}
+
+// Map file into read-only memory (internal) (1: success, 0: failure)
+//
+// Only non-empty files are mapped. Text files (text = 1) must also end with
+// '\n', so that every line of the mapped buffer is terminated inside the
+// mapping (the mapping itself is not null-terminated). Other files are left to
+// ReadBuff().
+static int MapBuff(const char *filename, buffer_t *buffer, int text)
+{
+#ifndef _WIN32
+    // Open the file
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return 0;
+
+    // Get file size
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+    size_t size = (size_t)st.st_size;
+
+    // A file filling whole pages has no zero-filled tail after the data to
+    // stop sscanf and strtod at the end of the mapping (read it instead)
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0 || size % (size_t)page == 0) {
+        close(fd);
+        return 0;
+    }
+
+    // Map the file (the mapping stays valid after closing the descriptor)
+    void *addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return 0;
+
+    // Check trailing '\n'
+    char *buff = (char*)addr;
+    if (text && buff[size - 1] != '\n') {
+        munmap(addr, size);
+        return 0;
+    }
+
+    // Readers scan the file once from the top
+#ifdef MADV_SEQUENTIAL
+    madvise(addr, size, MADV_SEQUENTIAL);
+#endif
+
+    buffer->buff = buff;
+    buffer->size = size;
+    buffer->map = 1;
+
+    return 1;
+#else
+    (void)filename;
+    (void)buffer;
+    (void)text;
+    return 0;
+#endif
+}
+
+// Append line to line table, growing it as needed (internal) (1: success, 0: failure)
+//
+// The line [start, nl) excludes the '\n' at nl; a '\r' before it (CR/LF) is
+// excluded from the line length instead of being removed from the data.
+static inline int AddLine(buffer_t *buffer, size_t *nmax, size_t start, size_t nl)
+{
+    if (buffer->nline >= *nmax) {
+        size_t nnew = *nmax * 2;
+        lineinfo_t *lineinfo = (lineinfo_t*)realloc(buffer->lineinfo, nnew * sizeof(lineinfo_t));
+        if (!lineinfo) return 0;
+        buffer->lineinfo = lineinfo;
+        *nmax = nnew;
+    }
+
+    size_t len = nl - start;
+    if (len > 0 && buffer->buff[nl-1] == '\r') len--;
+
+    lineinfo_t *info = buffer->lineinfo + buffer->nline++;
+    info->start = start;
+    info->end = start + len - 1;
+    info->len = len;
+
+    return 1;
+}
+
+// Index lines with memchr search (internal) (1: success, 0: failure)
+static int IndexLinesScalar(buffer_t *buffer, size_t *nmax, size_t *last)
+{
+    const char *buff = buffer->buff;
+    size_t size = buffer->size, start = 0;
+
+    while (start < size) {
+        const char *p = (const char*)memchr(buff + start, '\n', size - start);
+        if (!p) break;
+        size_t nl = (size_t)(p - buff);
+        if (!AddLine(buffer, nmax, start, nl)) return 0;
+        start = nl + 1;
+    }
+    *last = start;
+    return 1;
+}
+
+#ifdef FILES_SIMD_X86
+// Index lines with AVX2 (32 bytes per compare) (internal) (1: success, 0: failure)
+__attribute__((target("avx2")))
+static int IndexLinesAvx2(buffer_t *buffer, size_t *nmax, size_t *last)
+{
+    const char *buff = buffer->buff;
+    size_t size = buffer->size, start = 0, i = 0;
+    const __m256i nl = _mm256_set1_epi8('\n');
+
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(buff + i));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl));
+        while (mask) {
+            size_t pos = i + (size_t)__builtin_ctz(mask);
+            if (!AddLine(buffer, nmax, start, pos)) return 0;
+            start = pos + 1;
+            mask &= mask - 1;
+        }
+    }
+    for (; i < size; i++) {
+        if (buff[i] != '\n') continue;
+        if (!AddLine(buffer, nmax, start, i)) return 0;
+        start = i + 1;
+    }
+    *last = start;
+    return 1;
+}
+#endif
+
+// Index lines of the buffer in one pass (internal) (1: success, 0: failure)
+//
+// The line table grows on the fly. The '\n' search uses AVX2 (32 bytes per
+// compare) when the CPU supports it (checked at runtime), otherwise memchr.
+static int IndexLines(buffer_t *buffer)
+{
+    const char *buff = buffer->buff;
+    size_t size = buffer->size;
+
+    // Allocate initial line table from expected line length
+    size_t nmax = size / LINE_LEN_HINT + 16;
+    buffer->lineinfo = (lineinfo_t*)malloc(nmax * sizeof(lineinfo_t));
+    buffer->nline = 0;
+    if (!buffer->lineinfo) return 0;
+
+    // Index lines terminated by '\n'
+    size_t last = 0;
+    int info;
+#ifdef FILES_SIMD_X86
+    if (__builtin_cpu_supports("avx2")) {
+        info = IndexLinesAvx2(buffer, &nmax, &last);
+    }
+    else {
+        info = IndexLinesScalar(buffer, &nmax, &last);
+    }
+#else
+    info = IndexLinesScalar(buffer, &nmax, &last);
+#endif
+    if (!info) return 0;
+
+    // Last line if missing '\n' (or empty buffer)
+    if (size == 0 || buff[size-1] != '\n') {
+        if (!AddLine(buffer, &nmax, last, size)) return 0;
+    }
+
+    return 1;
+}
+
+// Check if the host byte order is little-endian (internal) (1: little, 0: big)
+static inline int IsLittleEndian(void)
+{
+    const uint32_t one = 1;
+    return *(const unsigned char*)&one == 1;
+}
+
+// Offset of the first cache file record after header of given size (internal)
+static inline size_t CacheOffset(size_t size)
+{
+    return (size + CACHE_ALIGN - 1) / CACHE_ALIGN * CACHE_ALIGN;
+}
+
+// Add bytes to 64-bit FNV-1a hash (internal)
+static uint64_t HashBytes(uint64_t hash, const void *data, size_t size)
+{
+    const unsigned char *p = (const unsigned char*)data;
+
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Add size and modification time of file to hash (internal) (1: success, 0: failure)
+static int HashFile(uint64_t *hash, const char *filename)
+{
+    struct stat st;
+    if (stat(filename, &st) != 0) return 0;
+
+    int64_t src[2] = {(int64_t)st.st_size, (int64_t)st.st_mtime};
+    *hash = HashBytes(*hash, src, sizeof(src));
+
+    return 1;
+}
+
+// Get observation cache stamp of source file (internal) (1: success, 0: failure)
+//
+// The stamp hashes the source file size and modification time, the record
+// layout (observation data size, NFREQ, NSYS, NSAT), and the read filter of
+// the processing options, so that a cache is fresh only for the same source
+// read the same way.
+static int ObsCacheStamp(const char *filename, const opt_t *opt, uint64_t *stamp)
+{
+    int32_t lay[4] = {(int32_t)sizeof(obs_t), NFREQ, NSYS, NSAT};
+
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    if (!HashFile(&hash, filename)) return 0;
+    hash = HashBytes(hash, lay, sizeof(lay));
+    if (opt) {
+        double flt[3] = {opt->ts, opt->te, opt->ti};
+        hash = HashBytes(hash, flt, sizeof(flt));
+        hash = HashBytes(hash, opt->rdexsats, sizeof(opt->rdexsats));
+    }
+    *stamp = hash;
+
+    return 1;
+}
+
+// Get navigation cache stamp of source files (internal) (1: success, 0: failure)
+//
+// The stamp hashes the name, size and modification time of every source file
+// in order and the record layout (ephemeris data size, NSYS, NSAT).
+static int NavCacheStamp(const files_t *files, uint64_t *stamp)
+{
+    int32_t lay[3] = {(int32_t)sizeof(eph_t), NSYS, NSAT};
+
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    hash = HashBytes(hash, lay, sizeof(lay));
+    for (int i = 0; i < files->n; i++) {
+        const char *filename = GetFileName(files, i);
+        if (!filename || !HashFile(&hash, filename)) return 0;
+        hash = HashBytes(hash, filename, strlen(filename) + 1);
+    }
+    *stamp = hash;
+
+    return 1;
+}
+
+// Get observation cache file name of source file (internal) (1: success, 0: failure)
+static int ObsCachePath(const char *filename, char *path, size_t size)
+{
+    size_t len = strlen(filename);
+    if (len + sizeof(OBS_CACHE_EXT) > size) return 0;
+
+    memcpy(path, filename, len);
+    memcpy(path + len, OBS_CACHE_EXT, sizeof(OBS_CACHE_EXT));
+
+    return 1;
+}
+
+// Open temporary cache file and write header padded to record alignment (internal)
+// (NULL if failed)
+static FILE *OpenCache(const char *temp, const void *head, size_t size)
+{
+    FILE *fp = fopen(temp, "wb");
+    if (!fp) return NULL;
+
+    char pad[CACHE_ALIGN] = {0};
+    size_t npad = CacheOffset(size) - size;
+    if (fwrite(head, size, 1, fp) != 1 || fwrite(pad, 1, npad, fp) != npad) {
+        fclose(fp);
+        remove(temp);
+        return NULL;
+    }
+    return fp;
+}
+
+// Close temporary cache file and replace cache file with it (internal)
+// (1: success, 0: failure)
+//
+// Readers never see a partially written cache file. The temporary file is
+// removed if writing failed (info = 0).
+static int CloseCache(FILE *fp, const char *temp, const char *path, int info)
+{
+    if (fclose(fp) != 0) info = 0;
+
+#ifdef _WIN32
+    if (info) remove(path);
+#endif
+    if (!info || rename(temp, path) != 0) {
+        remove(temp);
+        return 0;
+    }
+    return 1;
+}
+
+#ifndef _WIN32
+// Worker of file reading pool: run tasks until none is left
+static void *PoolWorker(void *arg)
+{
+    filePool_t *pool = (filePool_t*)arg;
+
+    while (1) {
+
+        // Take next task index
+        pthread_mutex_lock(&pool->lock);
+        int i = pool->next++;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (i >= pool->ntask) break;
+        pool->func(pool->arg, i);
+    }
+
+    return NULL;
+}
+
+// Run func(arg, i) for i = 0, ..., ntask-1 on nthread threads (calling thread included)
+//
+// Tasks are taken in order by whichever thread is free. If threads cannot be
+// created, the remaining tasks run on the calling thread.
+static void RunPool(void (*func)(void *, int), void *arg, int ntask, int nthread)
+{
+    filePool_t pool;
+    pool.func  = func;
+    pool.arg   = arg;
+    pool.ntask = ntask;
+    pool.next  = 0;
+    pthread_mutex_init(&pool.lock, NULL);
+
+    if (nthread > ntask) nthread = ntask;
+    if (nthread > MAX_FILE_THREAD) nthread = MAX_FILE_THREAD;
+
+    pthread_t thread[MAX_FILE_THREAD];
+    int nrun = 0;
+    for (int k = 1; k < nthread; k++) {
+        if (!pthread_create(&thread[nrun], NULL, PoolWorker, &pool)) nrun++;
+    }
+    PoolWorker(&pool);
+
+    for (int k = 0; k < nrun; k++) pthread_join(thread[k], NULL);
+    pthread_mutex_destroy(&pool.lock);
+}
+
+// Read observation file i into private observation data (pool task)
+static void ReadObsFileTask(void *arg, int i)
+{
+    obsFile_t *file = (obsFile_t*)arg + i;
+
+    // Navigation data of the task (receives station information only)
+    nav_t nav;
+    memset(&nav, 0, sizeof(nav_t));
+    nav.opt = file->opt;
+    int cache = nav.opt && nav.opt->obscache;
+
+    // Load the observation cache if enabled and fresh, otherwise read the file
+    file->info = cache && ReadObsCache(&nav, &file->obs, 1, file->filename);
+    if (!file->info) {
+        file->info = ReadRnxObs(&nav, &file->obs, 1, file->filename);
+        if (file->info && cache) WriteObsCache(&nav, &file->obs, 1, file->filename);
+    }
+    if (file->info) file->sta = nav.sta[0];
+}
+
+// Read navigation file i into private navigation data (pool task)
+static void ReadNavFileTask(void *arg, int i)
+{
+    navFile_t *file = (navFile_t*)arg + i;
+
+    file->info = ReadRnxNav(&file->nav, file->filename);
+}
+
+// Merge ephemerides of satellite i from all files in file order and sort (pool task)
+static void MergeNavTask(void *arg, int i)
+{
+    navMerge_t *merge = (navMerge_t*)arg;
+    ephs_t *ephs = &merge->nav->ephs[i];
+
+    // Reserve ephemeris data of all files
+    int n = ephs->n;
+    for (int f = 0; f < merge->nfile; f++) n += merge->file[f].nav.ephs[i].n;
+    ReserveEphs(ephs, n);
+
+    for (int f = 0; f < merge->nfile; f++) {
+        const ephs_t *src = &merge->file[f].nav.ephs[i];
+        for (int j = 0; j < src->n; j++) {
+            if (!AddEph(ephs, &src->eph[j])) break;
+        }
+    }
+
+    // Remove duplicated data and sort ephemeris data by time transmission
+    if (ephs->n > 0) SortEphs(ephs);
+}
+#endif
+
 // =============================================================================
 // File string functions
 // =============================================================================
@@ -167,6 +680,8 @@ int InitBuff(buffer_t *buffer)
     buffer->buff = NULL;
     buffer->lineinfo = NULL;
     buffer->nline = 0;
+    buffer->size = 0;
+    buffer->map = 0;
 
     return 1;
 }
@@ -175,90 +690,38 @@ int InitBuff(buffer_t *buffer)
 int GetBuff(const char *filename, buffer_t *buffer)
 {
     // Check if the buffer is valid
-    if (!buffer) return 0;
+    if (!buffer || !filename) return 0;
 
-    // Open the file
-    FILE *fp = fopen(filename, "rb");
-    if (!fp) return 0;
-
-    // Get file size
-    fseek(fp, 0, SEEK_END);
-    size_t size = ftell(fp);
-    rewind(fp);
-
-    // Allocate memory for the buffer
-    char *buff = (char*)malloc(size + 1);
-    if (!buff) {
-        fclose(fp);
-        return 0;
-    }
+    // Map the file (read-only, zero-copy) or read it into heap memory
+    if (!MapBuff(filename, buffer, 1) && !ReadBuff(filename, buffer)) return 0;
 
-    // Read the file into the buffer
-    size_t nread = fread(buff, 1, size, fp);
-    if (nread != size) {
-        free(buff);
-        fclose(fp);
+    // Decompress gzip, UNIX compress and compact RINEX data
+    if (!DecompBuff(buffer)) {
+        FreeBuff(buffer);
         return 0;
     }
 
-    // Close the file
-    fclose(fp);
-
-    // Null terminate the buffer
-    buff[size] = '\0';
-
-    // Remove '\r' from the buffer
-    size_t j = 0;
-    for (size_t i = 0; i < size; i++) {
-        if (buff[i] != '\r') {
-            buff[j++] = buff[i];
-        }
-    }
-    buff[j] = '\0';
-    size = j;
-
-    // Count the number of lines
-    size_t nline = 0;
-    for (size_t i = 0; i < size; i++) {
-        if (buff[i] == '\n') nline++;
-    }
-
-    // Check for last line without trailing '\n'
-    if (size == 0 || buff[size-1] != '\n') nline++;
-
-    // Allocate memory for the line information
-    lineinfo_t *lineinfo = (lineinfo_t*)malloc(nline * sizeof(lineinfo_t));
-    if (!lineinfo) {
-        free(buff);
+    // Index lines of the buffer
+    if (!IndexLines(buffer)) {
+        FreeBuff(buffer);
         return 0;
     }
 
-    // Set the line information
-    size_t start = 0;
-    size_t idx = 0;
-    for (size_t i = 0; i < size; i++) {
-        if (buff[i] == '\n') {
-            lineinfo[idx].start = start;
-            lineinfo[idx].end = i - 1;
-            lineinfo[idx].len = i - start;
-            start = i + 1;
-            idx++;
-        }
-    }
+    return 1;
+}
 
-    // Last line if missing '\n'
-    if (start < size) {
-        lineinfo[idx].start = start;
-        lineinfo[idx].end = size - 1;
-        lineinfo[idx].len = size - start;
-    }
+// Index lines of buffer data
+int IndexBuff(buffer_t *buffer)
+{
+    // Check if the buffer is valid
+    if (!buffer || !buffer->buff) return 0;
 
-    // Set the number of lines
-    buffer->buff = buff;
-    buffer->lineinfo = lineinfo;
-    buffer->nline = nline;
+    // Free previous line table
+    if (buffer->lineinfo) free(buffer->lineinfo);
+    buffer->lineinfo = NULL;
+    buffer->nline = 0;
 
-    return 1;
+    return IndexLines(buffer);
 }
 
 // Free file buffer
@@ -266,12 +729,19 @@ void FreeBuff(buffer_t *buffer)
 {
     if (!buffer) return;
 
+#ifndef _WIN32
+    if (buffer->buff && buffer->map) munmap(buffer->buff, buffer->size);
+    else if (buffer->buff) free(buffer->buff);
+#else
     if (buffer->buff) free(buffer->buff);
+#endif
     if (buffer->lineinfo) free(buffer->lineinfo);
 
     buffer->buff = NULL;
     buffer->lineinfo = NULL;
     buffer->nline = 0;
+    buffer->size = 0;
+    buffer->map = 0;
 }
 
 // Read observation data files (RINEX OBS, RTCM (TBD), UBX (TBD))
@@ -293,6 +763,9 @@ void ReadObsFiles(files_t *files, nav_t *nav, obss_t *obs)
         }
     }
 
+    // Observation cache files of the sources (opt-in)
+    int cache = nav->opt && nav->opt->obscache;
+
     // Loop through all observation files
     for (int i = 0; i < nfiles; i++) {
 
@@ -303,8 +776,17 @@ void ReadObsFiles(files_t *files, nav_t *nav, obss_t *obs)
         // Check if file name is the RINEX obs file name
         if (IsRinexObs(filename)) {
 
-            // Read RINEX observation file
-            if (ReadRnxObs(nav, obs, ridx, filename)) ridx++;
+            // Load the observation cache if enabled and fresh
+            if (cache && ReadObsCache(nav, obs, ridx, filename)) {
+                ridx++;
+                continue;
+            }
+
+            // Read RINEX observation file and cache it if enabled
+            if (ReadRnxObs(nav, obs, ridx, filename)) {
+                if (cache) WriteObsCache(nav, obs, ridx, filename);
+                ridx++;
+            }
         }
     }
 
@@ -343,13 +825,147 @@ void ReadNavFiles(files_t *files, nav_t *nav)
 
     // Remove duplicated data and sort ephemeris data by time transmission
     for (int i = 0; i < NSAT; i++) {
-        if (nav->ephs[i].n > 1) {
+        if (nav->ephs[i].n > 0) {
             SortEphs(&nav->ephs[i]);
         }
     }
 
 }
 
+// Read observation data files in parallel
+void ReadObsFilesPar(files_t *files, nav_t *nav, obss_t *obs, int nthread)
+{
+#ifdef _WIN32
+    nthread = 1; // No pthreads: serial read
+#endif
+    if (nthread <= 1) {
+        ReadObsFiles(files, nav, obs);
+        return;
+    }
+
+#ifndef _WIN32
+    // Check if the files, navigation, and observation structures are valid
+    if (!files || !nav || !obs || files->n <= 0) return;
+
+    // Get next available receiver index from current observation data
+    int ridx = 1;
+    for (int i = 0; i < obs->n; i++) {
+        if (obs->obs[i].rcv >= ridx) {
+            ridx = obs->obs[i].rcv + 1;
+        }
+    }
+
+    // Collect RINEX observation files
+    obsFile_t *file = (obsFile_t*)malloc(files->n * sizeof(obsFile_t));
+    if (!file) return;
+
+    int nfile = 0;
+    for (int i = 0; i < files->n; i++) {
+        const char *filename = GetFileName(files, i);
+        if (!filename || !IsRinexObs(filename)) continue;
+
+        file[nfile].filename = filename;
+        file[nfile].info = 0;
+        file[nfile].opt = nav->opt;
+        InitObss(&file[nfile].obs);
+        nfile++;
+    }
+
+    // Read files on worker pool
+    RunPool(ReadObsFileTask, file, nfile, nthread);
+
+    // Reserve observation data of all files
+    int nobs = obs->n;
+    for (int f = 0; f < nfile; f++) {
+        if (file[f].info) nobs += file[f].obs.n;
+    }
+    ReserveObss(obs, nobs);
+
+    // Merge in file order (receiver index assigned to successfully read files)
+    for (int f = 0; f < nfile; f++) {
+
+        if (file[f].info && ridx <= NRCV) {
+            nav->sta[ridx - 1] = file[f].sta;
+
+            for (int i = 0; i < file[f].obs.n; i++) {
+                file[f].obs.obs[i].rcv = ridx;
+                if (!AddObs(obs, &file[f].obs.obs[i])) break;
+            }
+            ridx++;
+        }
+        FreeObss(&file[f].obs);
+    }
+    free(file);
+
+    // Remove duplicated data and sort observation data by time, receiver index,
+    // and satellite index in ascending order
+    if (obs->n > 1) {
+        SortObss(obs);
+    }
+#endif
+}
+
+// Read navigation data files in parallel
+void ReadNavFilesPar(files_t *files, nav_t *nav, int nthread)
+{
+#ifdef _WIN32
+    nthread = 1; // No pthreads: serial read
+#endif
+    if (nthread <= 1) {
+        ReadNavFiles(files, nav);
+        return;
+    }
+
+#ifndef _WIN32
+    // Check if the files and navigation structures are valid
+    if (!files || !nav || files->n <= 0) return;
+
+    // Collect RINEX navigation files
+    navFile_t *file = (navFile_t*)malloc(files->n * sizeof(navFile_t));
+    if (!file) return;
+
+    int nfile = 0;
+    for (int i = 0; i < files->n; i++) {
+        const char *filename = GetFileName(files, i);
+        if (!filename || !IsRinexNav(filename)) continue;
+
+        file[nfile].filename = filename;
+        file[nfile].info = 0;
+        if (!InitNav(&file[nfile].nav)) {
+            FreeNav(&file[nfile].nav);
+            continue;
+        }
+        nfile++;
+    }
+
+    // Read files on worker pool
+    RunPool(ReadNavFileTask, file, nfile, nthread);
+
+    // Update broadcast ionospheric parameters in file order (non-zero only)
+    for (int f = 0; f < nfile; f++) {
+        for (int c = 0; c < NSYS; c++) {
+            int anyNonZero = 0;
+            for (int j = 0; j < 8; j++) {
+                if (file[f].nav.iono[c][j] != 0.0) anyNonZero = 1;
+            }
+            if (!anyNonZero) continue;
+
+            for (int j = 0; j < 8; j++) nav->iono[c][j] = file[f].nav.iono[c][j];
+        }
+    }
+
+    // Merge and sort ephemerides per satellite on worker pool
+    navMerge_t merge;
+    merge.nav   = nav;
+    merge.file  = file;
+    merge.nfile = nfile;
+    RunPool(MergeNavTask, &merge, NSAT, nthread);
+
+    for (int f = 0; f < nfile; f++) FreeNav(&file[f].nav);
+    free(file);
+#endif
+}
+
 // Read DCB data files
 void ReadDcbFiles(files_t *files, nav_t *nav)
 {
@@ -373,6 +989,225 @@ void ReadFiles(file_t *file, nav_t *nav, obss_t *obs)
     ReadAtxFiles(&file->atxfiles, nav);
 }
 
+// =============================================================================
+// Observation cache functions
+// =============================================================================
+
+// Read observation cache file of source file (1: success, 0: failure)
+int ReadObsCache(nav_t *nav, obss_t *obs, int rcvidx, const char *filename)
+{
+    // Check if the arguments are valid
+    if (!nav || !obs || !filename || rcvidx <= 0 || rcvidx > NRCV) return 0;
+
+    // Records are stored little-endian
+    if (!IsLittleEndian()) return 0;
+
+    // Get stamp of the source file and cache file name
+    uint64_t stamp;
+    char path[MAX_FILE_NAME_LEN];
+    if (!ObsCacheStamp(filename, nav->opt, &stamp) ||
+        !ObsCachePath(filename, path, sizeof(path))) return 0;
+
+    // Map the cache file (read-only) or read it into heap memory
+    buffer_t buffer;
+    InitBuff(&buffer);
+    if (!MapBuff(path, &buffer, 0) && !ReadBuff(path, &buffer)) return 0;
+
+    // Check the header (stale or foreign cache is ignored)
+    size_t off = CacheOffset(sizeof(obsCacheHead_t));
+    obsCacheHead_t head;
+    int info = buffer.size >= off;
+    if (info) {
+        memcpy(&head, buffer.buff, sizeof(head));
+        info = !memcmp(head.magic, OBS_CACHE_MAGIC, sizeof(OBS_CACHE_MAGIC)) &&
+               head.ver == OBS_CACHE_VER && head.sizeObs == sizeof(obs_t) &&
+               head.stamp == stamp && head.n <= (uint64_t)(INT_MAX - obs->n) &&
+               buffer.size == off + head.n * sizeof(obs_t);
+    }
+
+    // Copy records to observation data in one block
+    int n = info ? (int)head.n : 0;
+    if (info && n > 0) {
+        info = ReserveObss(obs, obs->n + n);
+        if (info) {
+            obs_t *dst = obs->obs + obs->n;
+            memcpy(dst, buffer.buff + off, (size_t)n * sizeof(obs_t));
+            for (int i = 0; i < n; i++) dst[i].rcv = rcvidx;
+            obs->n += n;
+        }
+    }
+    FreeBuff(&buffer);
+
+    // Set station information
+    if (info) nav->sta[rcvidx - 1] = head.sta;
+
+    return info;
+}
+
+// Write observation cache file of source file (1: success, 0: failure)
+int WriteObsCache(const nav_t *nav, const obss_t *obs, int rcvidx, const char *filename)
+{
+    // Check if the arguments are valid
+    if (!nav || !obs || !filename || rcvidx <= 0 || rcvidx > NRCV) return 0;
+
+    // Records are stored little-endian
+    if (!IsLittleEndian()) return 0;
+
+    // Get stamp of the source file and cache file names
+    obsCacheHead_t head;
+    memset(&head, 0, sizeof(head));
+    char path[MAX_FILE_NAME_LEN], temp[MAX_FILE_NAME_LEN + 4];
+    if (!ObsCacheStamp(filename, nav->opt, &head.stamp) ||
+        !ObsCachePath(filename, path, sizeof(path))) return 0;
+    sprintf(temp, "%s.tmp", path);
+
+    // Set the header
+    memcpy(head.magic, OBS_CACHE_MAGIC, sizeof(OBS_CACHE_MAGIC));
+    head.ver = OBS_CACHE_VER;
+    head.sizeObs = (uint32_t)sizeof(obs_t);
+    head.n = 0;
+    for (int i = 0; i < obs->n; i++) {
+        if (obs->obs[i].rcv == rcvidx) head.n++;
+    }
+    head.sta = nav->sta[rcvidx - 1];
+
+    // Write the header and the records
+    FILE *fp = OpenCache(temp, &head, sizeof(head));
+    if (!fp) return 0;
+
+    int info = 1;
+    for (int i = 0; info && i < obs->n; ) {
+
+        // Write runs of records of the receiver
+        if (obs->obs[i].rcv != rcvidx) {
+            i++;
+            continue;
+        }
+        int j = i + 1;
+        while (j < obs->n && obs->obs[j].rcv == rcvidx) j++;
+        info = fwrite(obs->obs + i, sizeof(obs_t), (size_t)(j - i), fp) == (size_t)(j - i);
+        i = j;
+    }
+
+    return CloseCache(fp, temp, path, info);
+}
+
+// =============================================================================
+// Navigation cache functions
+// =============================================================================
+
+// Read navigation cache file of source files (1: success, 0: failure)
+int ReadNavCache(nav_t *nav, const files_t *files, const char *filename)
+{
+    // Check if the arguments are valid
+    if (!nav || !files || !filename) return 0;
+
+    // Records are stored little-endian
+    if (!IsLittleEndian()) return 0;
+
+    // Get stamp of the source files
+    uint64_t stamp;
+    if (!NavCacheStamp(files, &stamp)) return 0;
+
+    // Map the cache file (read-only) or read it into heap memory
+    buffer_t buffer;
+    InitBuff(&buffer);
+    if (!MapBuff(filename, &buffer, 0) && !ReadBuff(filename, &buffer)) return 0;
+
+    // Check the header (stale or foreign cache is ignored)
+    size_t off = CacheOffset(sizeof(navCacheHead_t));
+    navCacheHead_t head;
+    int info = buffer.size >= off;
+    if (info) {
+        memcpy(&head, buffer.buff, sizeof(head));
+        info = !memcmp(head.magic, NAV_CACHE_MAGIC, sizeof(NAV_CACHE_MAGIC)) &&
+               head.ver == NAV_CACHE_VER && head.sizeEph == sizeof(eph_t) &&
+               head.stamp == stamp && buffer.size == off + head.n * sizeof(eph_t);
+    }
+    if (info) {
+        uint64_t n = 0;
+        for (int i = 0; i < NSAT; i++) {
+            if (head.neph[i] < 0) info = 0;
+            else n += (uint64_t)head.neph[i];
+        }
+        if (n != head.n) info = 0;
+    }
+
+    // Reserve ephemeris data of all satellites (nav is unchanged if failed)
+    for (int i = 0; info && i < NSAT; i++) {
+        info = ReserveEphs(&nav->ephs[i], head.neph[i]);
+    }
+
+    // Replace ephemeris data of each satellite by its block of records
+    if (info) {
+        const char *rec = buffer.buff + off;
+        for (int i = 0; i < NSAT; i++) {
+            size_t size = (size_t)head.neph[i] * sizeof(eph_t);
+            if (size > 0) memcpy(nav->ephs[i].eph, rec, size);
+            nav->ephs[i].n = head.neph[i];
+            rec += size;
+
+            // Build time index and prepared ephemeris of the arranged records
+            IndexEphs(&nav->ephs[i]);
+        }
+
+        // Ionosphere parameters and GLONASS FCN
+        memcpy(nav->iono, head.iono, sizeof(nav->iono));
+        for (int prn = MIN_PRN_GLO; prn <= MAX_PRN_GLO && NSAT_GLO > 0; prn++) {
+            int fcn = head.fcn[prn - MIN_PRN_GLO];
+            if (fcn != -99) SetFcn(prn, fcn);
+        }
+    }
+    FreeBuff(&buffer);
+
+    return info;
+}
+
+// Write navigation cache file of source files (1: success, 0: failure)
+int WriteNavCache(const nav_t *nav, const files_t *files, const char *filename)
+{
+    // Check if the arguments are valid
+    if (!nav || !files || !filename) return 0;
+
+    // Records are stored little-endian
+    if (!IsLittleEndian()) return 0;
+
+    // Get stamp of the source files and temporary file name
+    navCacheHead_t head;
+    memset(&head, 0, sizeof(head));
+    if (!NavCacheStamp(files, &head.stamp)) return 0;
+
+    char temp[MAX_FILE_NAME_LEN + 4];
+    if (strlen(filename) >= MAX_FILE_NAME_LEN) return 0;
+    sprintf(temp, "%s.tmp", filename);
+
+    // Set the header
+    memcpy(head.magic, NAV_CACHE_MAGIC, sizeof(NAV_CACHE_MAGIC));
+    head.ver = NAV_CACHE_VER;
+    head.sizeEph = (uint32_t)sizeof(eph_t);
+    for (int i = 0; i < NSAT; i++) {
+        head.neph[i] = nav->ephs[i].n;
+        head.n += (uint64_t)nav->ephs[i].n;
+    }
+    for (int prn = MIN_PRN_GLO; prn <= MAX_PRN_GLO && NSAT_GLO > 0; prn++) {
+        int fcn;
+        head.fcn[prn - MIN_PRN_GLO] = GetFcn(prn, &fcn) ? fcn : -99;
+    }
+    memcpy(head.iono, nav->iono, sizeof(head.iono));
+
+    // Write the header and the records of each satellite in order
+    FILE *fp = OpenCache(temp, &head, sizeof(head));
+    if (!fp) return 0;
+
+    int info = 1;
+    for (int i = 0; info && i < NSAT; i++) {
+        size_t n = (size_t)nav->ephs[i].n;
+        if (n > 0) info = fwrite(nav->ephs[i].eph, sizeof(eph_t), n, fp) == n;
+    }
+
+    return CloseCache(fp, temp, filename, info);
+}
+
 // =============================================================================
 // End of file
 // =============================================================================
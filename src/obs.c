@@ -8,9 +8,21 @@
 #include "obs.h"
 #include "common.h"     // for GetFcn, Sat2Prn, Sys2Str, Str2Sys
 #include "ephemeris.h"  // for GetEphType
-#include <string.h>     // for strcmp, strncpy, strchr
-#include <stdlib.h>     // for qsort
-#include <math.h>       // for fabs
+#include <string.h>     // for strcmp, strncpy, strchr, memset
+#include <stdlib.h>     // for qsort, malloc, realloc, free
+#include <math.h>       // for fabs, llround
+#include <stdint.h>     // for int64_t, uint64_t
+
+// =============================================================================
+// Macros
+// =============================================================================
+
+#define MAX_PACK_VAL 1E15               // Maximum value encoded in 0.001 units
+#define MAX_PACK_REC (29 + NFREQ * 61)  // Maximum size of encoded observation data [bytes]
+
+#if NFREQ > 6
+#error "frequency mask of compact observation data is limited to 6 frequencies"
+#endif
 
 // =============================================================================
 // Static type definitions
@@ -21,6 +33,12 @@ typedef struct fmap {       // Frequency band and attribute struct
     char *attr;             // Frequency attribute string
 } fmap_t;
 
+typedef struct obsKey {     // Observation sort key
+    double time;            // Standard time (GPST)
+    int    id;              // Receiver and satellite index ((rcv << 16) | sat)
+    int    idx;             // Index of observation data
+} obsKey_t;
+
 // =============================================================================
 // Static global variables
 // =============================================================================
@@ -670,6 +688,175 @@ static int ResizeObss(obss_t *obss, int nnew)
     return 1;
 }
 
+// Resize a column of observation column data
+static int ResizeObsCol(void **col, int nnew, size_t size)
+{
+    void *newCol = realloc(*col, nnew * size);
+    if (!newCol) return 0;
+
+    *col = newCol;
+
+    return 1;
+}
+
+// Resize observation column data structure
+static int ResizeObsCols(obsCols_t *cols, int nnew)
+{
+    // Check if the observation column data structure is valid
+    if (!cols || nnew <= 0) return 0;
+
+    // Resize all columns (capacity is updated only if all succeed)
+    if (!ResizeObsCol((void **)&cols->time, nnew, sizeof(double)) ||
+        !ResizeObsCol((void **)&cols->rcv , nnew, sizeof(int   )) ||
+        !ResizeObsCol((void **)&cols->sat , nnew, sizeof(int   ))) return 0;
+
+    for (int f = 0; f < NFREQ; f++) {
+        if (!ResizeObsCol((void **)&cols->code[f], nnew, sizeof(int   )) ||
+            !ResizeObsCol((void **)&cols->P   [f], nnew, sizeof(double)) ||
+            !ResizeObsCol((void **)&cols->L   [f], nnew, sizeof(double)) ||
+            !ResizeObsCol((void **)&cols->D   [f], nnew, sizeof(double)) ||
+            !ResizeObsCol((void **)&cols->SNR [f], nnew, sizeof(double)) ||
+            !ResizeObsCol((void **)&cols->LLI [f], nnew, sizeof(int   ))) return 0;
+    }
+    cols->nmax = nnew;
+
+    return 1;
+}
+
+// Set a row of observation column data
+static inline void SetObsCols(obsCols_t *cols, int i, const obs_t *obs)
+{
+    cols->time[i] = obs->time;
+    cols->rcv [i] = obs->rcv;
+    cols->sat [i] = obs->sat;
+
+    for (int f = 0; f < NFREQ; f++) {
+        cols->code[f][i] = obs->code[f];
+        cols->P   [f][i] = obs->P   [f];
+        cols->L   [f][i] = obs->L   [f];
+        cols->D   [f][i] = obs->D   [f];
+        cols->SNR [f][i] = obs->SNR [f];
+        cols->LLI [f][i] = obs->LLI [f];
+    }
+}
+
+// Encode signed integer as zigzag variable-length integer (return: bytes)
+static int PutVarint(unsigned char *p, int64_t val)
+{
+    uint64_t u = (val < 0) ? (((uint64_t)(-(val + 1)) << 1) | 1) : ((uint64_t)val << 1);
+    int n = 0;
+
+    while (u >= 0x80) {
+        p[n++] = (unsigned char)(u | 0x80);
+        u >>= 7;
+    }
+    p[n++] = (unsigned char)u;
+
+    return n;
+}
+
+// Decode zigzag variable-length integer (return: bytes, 0 if error)
+static int GetVarint(const unsigned char *p, const unsigned char *end, int64_t *val)
+{
+    uint64_t u = 0;
+    int n = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p + n >= end) return 0;
+        u |= (uint64_t)(p[n] & 0x7F) << shift;
+        if (!(p[n++] & 0x80)) {
+            *val = (u & 1) ? -(int64_t)(u >> 1) - 1 : (int64_t)(u >> 1);
+            return n;
+        }
+    }
+    return 0;
+}
+
+// Encode observation value relative to reference in 0.001 units (return: bytes)
+//
+// Tag bit 0: (value - ref) in 0.001 units, 1: value as it is (8 bytes follow).
+// *k is set to the value in 0.001 units if encoded so (unchanged otherwise).
+static int PutObsVal(unsigned char *p, double val, int64_t ref, int64_t *k)
+{
+    if (fabs(val) < MAX_PACK_VAL) {
+        int64_t kval = llround(val * 1E3);
+        if ((double)kval / 1E3 == val) {
+            *k = kval;
+            return PutVarint(p, (kval - ref) * 2);
+        }
+    }
+    int n = PutVarint(p, 1);
+    memcpy(p + n, &val, sizeof(double));
+
+    return n + (int)sizeof(double);
+}
+
+// Decode observation value (return: bytes, 0 if error)
+static int GetObsVal(const unsigned char *p, const unsigned char *end, int64_t ref,
+                     double *val, int64_t *k)
+{
+    int64_t tag;
+    int n = GetVarint(p, end, &tag);
+    if (n == 0) return 0;
+
+    if (tag == 1) {
+        if (end - (p + n) < (ptrdiff_t)sizeof(double)) return 0;
+        memcpy(val, p + n, sizeof(double));
+        return n + (int)sizeof(double);
+    }
+    *k = ref + tag / 2;
+    *val = (double)*k / 1E3;
+
+    return n;
+}
+
+// Encode observation data (return: bytes)
+//
+// flags (time changed, rcv changed, frequency mask), [time], [rcv], sat, then
+// per frequency: code, value mask (P, L, D, SNR) | LLI << 4, values
+static size_t EncodeObs(unsigned char *p, const obs_t *obs, int newtime, int newrcv)
+{
+    int vmask[NFREQ], fmask = 0;
+
+    for (int f = 0; f < NFREQ; f++) {
+        vmask[f] = (obs->P[f] != 0.0) | (obs->L[f] != 0.0) << 1 | (obs->D[f] != 0.0) << 2 |
+                   (obs->SNR[f] != 0.0) << 3;
+        if (vmask[f] || obs->code[f] || obs->LLI[f]) fmask |= 1 << f;
+    }
+
+    size_t n = 0;
+    p[n++] = (unsigned char)(newtime | newrcv << 1 | fmask << 2);
+    if (newtime) {
+        memcpy(p + n, &obs->time, sizeof(double));
+        n += sizeof(double);
+    }
+    if (newrcv) n += PutVarint(p + n, obs->rcv);
+    n += PutVarint(p + n, obs->sat);
+
+    const double *val[4] = {obs->P, obs->L, obs->D, obs->SNR};
+    int64_t refP = 0;
+    for (int f = 0; f < NFREQ; f++) {
+
+        if (!(fmask & (1 << f))) continue;
+
+        int lli = (obs->LLI[f] >= 0 && obs->LLI[f] < 15) ? obs->LLI[f] : 15;
+        n += PutVarint(p + n, obs->code[f]);
+        p[n++] = (unsigned char)(vmask[f] | lli << 4);
+        if (lli == 15) n += PutVarint(p + n, obs->LLI[f]);
+
+        // Values (pseudoranges after the first are relative to it)
+        for (int j = 0; j < 4; j++) {
+
+            if (!(vmask[f] & (1 << j))) continue;
+
+            int64_t k = 0;
+            n += PutObsVal(p + n, val[j][f], j == 0 ? refP : 0, &k);
+            if (j == 0 && refP == 0) refP = k;
+        }
+    }
+    return n;
+}
+
 // Compare observation data by time, receiver index, satellite index
 static int CompareObs(const void *a, const void *b)
 {
@@ -687,6 +874,91 @@ static int CompareObs(const void *a, const void *b)
     return obs1->sat - obs2->sat;
 }
 
+// Compare observation sort keys (same order as CompareObs)
+static inline int CompareObsKey(const obsKey_t *key1, const obsKey_t *key2)
+{
+    double dt = key1->time - key2->time;
+    if (dt > 1e-9 || dt < -1e-9) return (dt > 0.0) ? 1 : -1;
+
+    return (key1->id > key2->id) - (key1->id < key2->id);
+}
+
+// End of ascending run of sort keys starting at i (return: index after run)
+static int ObsKeyRun(const obsKey_t *key, int i, int n)
+{
+    for (i++; i < n && CompareObsKey(&key[i - 1], &key[i]) <= 0; i++) ;
+    return i;
+}
+
+// Sort keys by merging ascending runs (stable, 1: success, 0: failure)
+//
+// Each pass merges adjacent runs pairwise, so k runs (e.g. one per appended
+// file) take ceil(log2(k)) linear passes over the keys.
+static int SortObsKeys(obsKey_t **key, int n)
+{
+    obsKey_t *src = *key;
+    obsKey_t *dst = (obsKey_t *)malloc(n * sizeof(obsKey_t));
+    if (!dst) return 0;
+
+    while (1) {
+        int nrun = 0;
+
+        for (int i = 0; i < n; ) {
+
+            // Adjacent runs [i, j) and [j, k)
+            int j = ObsKeyRun(src, i, n);
+            int k = (j < n) ? ObsKeyRun(src, j, n) : n;
+            nrun++;
+
+            // Merge runs (left first if equal)
+            int a = i, b = j, m = i;
+            while (a < j && b < k) {
+                dst[m++] = (CompareObsKey(&src[b], &src[a]) < 0) ? src[b++] : src[a++];
+            }
+            while (a < j) dst[m++] = src[a++];
+            while (b < k) dst[m++] = src[b++];
+
+            i = k;
+        }
+
+        obsKey_t *tmp = src;
+        src = dst;
+        dst = tmp;
+
+        if (nrun <= 1) break;
+    }
+
+    free(dst);
+    *key = src;
+
+    return 1;
+}
+
+// Delete duplicate observation data of sorted observation data set in place
+static void UniqObss(obss_t *obss)
+{
+    int n = 0;
+    for (int i = 0; i < obss->n; i++) {
+
+        // Check if the observation data is the same as previous one
+        if (i > 0 &&
+            obss->obs[i].time == obss->obs[i-1].time &&
+            obss->obs[i].rcv  == obss->obs[i-1].rcv  &&
+            obss->obs[i].sat  == obss->obs[i-1].sat) {
+            continue;  // Skip duplicate
+        }
+
+        // Copy the observation data to the next position
+        if (n != i) {
+            obss->obs[n] = obss->obs[i];
+        }
+        n++;
+    }
+
+    // Update the number of observation data
+    obss->n = n;
+}
+
 // =============================================================================
 // Observation data structure functions
 // =============================================================================
@@ -736,38 +1008,496 @@ int AddObs(obss_t *obss, const obs_t *obs)
     return 1;
 }
 
+// Reserve memory of observation data set
+int ReserveObss(obss_t *obss, int n)
+{
+    // Check if the observation data set structure is valid
+    if (!obss || n < 0) return 0;
+
+    // Resize only if the memory is not enough
+    if (n <= obss->nmax) return 1;
+
+    return ResizeObss(obss, n);
+}
+
 // Sort observation data set by the order of time, receiver index, satellite index
+//
+// Appended files and epochs form ascending runs, so the (time, rcv, sat) keys
+// are sorted by run merging and the records are gathered once in key order,
+// dropping duplicates. Already sorted data is only deduplicated in place.
 void SortObss(obss_t *obss)
 {
     // Check if the observation data set structure is valid
     if (!obss || obss->n == 0) return;
 
-    // Sort the observation data set by the order of time, receiver index, satellite index
-    qsort(obss->obs, obss->n, sizeof(obs_t), CompareObs);
+    int n = obss->n;
+
+    // Build sort keys
+    obsKey_t *key = (obsKey_t *)malloc(n * sizeof(obsKey_t));
+    if (!key) {
+
+        // Fall back to sorting records
+        qsort(obss->obs, n, sizeof(obs_t), CompareObs);
+        UniqObss(obss);
+        return;
+    }
+
+    // (check if already sorted while building)
+    int sorted = 1;
+    for (int i = 0; i < n; i++) {
+        key[i].time = obss->obs[i].time;
+        key[i].id   = (obss->obs[i].rcv << 16) | obss->obs[i].sat;
+        key[i].idx  = i;
+        if (i > 0 && sorted && CompareObsKey(&key[i-1], &key[i]) > 0) sorted = 0;
+    }
+
+    // Sort keys unless already sorted
+    if (!sorted && !SortObsKeys(&key, n)) {
+        free(key);
+        qsort(obss->obs, n, sizeof(obs_t), CompareObs);
+        UniqObss(obss);
+        return;
+    }
+
+    // Permute observation data to key order in place (one move per record)
+    for (int i = 0; i < n; i++) {
+
+        if (key[i].idx == i) continue;
+
+        // Follow cycle: position j takes record key[j].idx
+        obs_t tmp = obss->obs[i];
+        int j = i;
+        while (key[j].idx != i) {
+            int k = key[j].idx;
+            obss->obs[j] = obss->obs[k];
+            key[j].idx = j;
+            j = k;
+        }
+        obss->obs[j] = tmp;
+        key[j].idx = j;
+    }
+
+    // Check duplicate observation data on keys
+    int dup = 0;
+    for (int i = 1; i < n && !dup; i++) {
+        dup = key[i].time == key[i-1].time && key[i].id == key[i-1].id;
+    }
+    free(key);
 
     // Delete duplicate observation data
-    int n = 0;
+    if (dup) UniqObss(obss);
+}
+
+// =============================================================================
+// Observation column data structure functions
+// =============================================================================
+
+// Initialize observation column data structure
+void InitObsCols(obsCols_t *cols)
+{
+    // Check if the observation column data structure is valid
+    if (!cols) return;
+
+    // Initialize the observation column data structure
+    memset(cols, 0, sizeof(obsCols_t));
+}
+
+// Free observation column data structure
+void FreeObsCols(obsCols_t *cols)
+{
+    // Check if the observation column data structure is valid
+    if (!cols) return;
+
+    // Free all columns
+    free(cols->time);
+    free(cols->rcv);
+    free(cols->sat);
+
+    for (int f = 0; f < NFREQ; f++) {
+        free(cols->code[f]);
+        free(cols->P   [f]);
+        free(cols->L   [f]);
+        free(cols->D   [f]);
+        free(cols->SNR [f]);
+        free(cols->LLI [f]);
+    }
+    InitObsCols(cols);
+}
+
+// Add observation data to observation column data (as the last row)
+int AddObsCols(obsCols_t *cols, const obs_t *obs)
+{
+    // Check if the observation column data structure is valid
+    if (!cols || !obs) return 0;
+
+    // Check if the observation column data is full
+    if (cols->n >= cols->nmax) {
+        int nnew = (cols->nmax == 0) ? 2 : cols->nmax * 2;
+        if (!ResizeObsCols(cols, nnew)) return 0;
+    }
+
+    // Add the observation data to the last row
+    SetObsCols(cols, cols->n, obs);
+    cols->n++;
+
+    return 1;
+}
+
+// Get observation data of a row of observation column data
+int GetObsCols(const obsCols_t *cols, int i, obs_t *obs)
+{
+    // Check if the observation column data structure and row are valid
+    if (!cols || !obs || i < 0 || i >= cols->n) return 0;
+
+    // Gather the row
+    obs->time = cols->time[i];
+    obs->rcv  = cols->rcv [i];
+    obs->sat  = cols->sat [i];
+
+    for (int f = 0; f < NFREQ; f++) {
+        obs->code[f] = cols->code[f][i];
+        obs->P   [f] = cols->P   [f][i];
+        obs->L   [f] = cols->L   [f][i];
+        obs->D   [f] = cols->D   [f][i];
+        obs->SNR [f] = cols->SNR [f][i];
+        obs->LLI [f] = cols->LLI [f][i];
+    }
+
+    return 1;
+}
+
+// Convert observation data set to observation column data
+int Obss2Cols(const obss_t *obss, obsCols_t *cols)
+{
+    // Check if the structures are valid
+    if (!obss || !cols) return 0;
+
+    // Allocate all rows at once
+    if (obss->n > cols->nmax && !ResizeObsCols(cols, obss->n)) return 0;
+
+    // Scatter records to columns in one pass over the records
     for (int i = 0; i < obss->n; i++) {
+        SetObsCols(cols, i, obss->obs + i);
+    }
+    cols->n = obss->n;
 
-        // Check if the observation data is the same as previous one
-        if (i > 0 &&
-            obss->obs[i].time == obss->obs[i-1].time &&
-            obss->obs[i].rcv  == obss->obs[i-1].rcv  &&
-            obss->obs[i].sat  == obss->obs[i-1].sat) {
-            continue;  // Skip duplicate
+    return 1;
+}
+
+// Convert observation column data to observation data set
+int Cols2Obss(const obsCols_t *cols, obss_t *obss)
+{
+    // Check if the structures are valid
+    if (!cols || !obss) return 0;
+
+    // Allocate all records at once
+    if (cols->n > obss->nmax && !ResizeObss(obss, cols->n)) return 0;
+
+    // Gather rows to records
+    for (int i = 0; i < cols->n; i++) {
+        GetObsCols(cols, i, obss->obs + i);
+    }
+    obss->n = cols->n;
+
+    return 1;
+}
+
+// =============================================================================
+// Observation epoch index functions
+// =============================================================================
+
+// Initialize observation epoch index structure
+void InitObsEpochs(obsEpochs_t *epochs)
+{
+    // Check if the observation epoch index structure is valid
+    if (!epochs) return;
+
+    // Initialize the observation epoch index structure
+    epochs->n = 0;
+    epochs->nmax = 0;
+    epochs->epoch = NULL;
+}
+
+// Free observation epoch index structure
+void FreeObsEpochs(obsEpochs_t *epochs)
+{
+    // Check if the observation epoch index structure is valid
+    if (!epochs) return;
+
+    // Free the observation epoch index structure
+    if (epochs->epoch) {
+        free(epochs->epoch);
+        epochs->epoch = NULL;
+    }
+    epochs->n = epochs->nmax = 0;
+}
+
+// Build observation epoch index of sorted observation data set
+int IndexObsEpochs(const obss_t *obss, obsEpochs_t *epochs)
+{
+    // Check if the structures are valid
+    if (!obss || !epochs) return 0;
+
+    epochs->n = 0;
+    if (obss->n <= 0) return 1;
+
+    // Count epochs (same time and receiver index as CompareObs)
+    const obs_t *obs = obss->obs;
+    int nep = 1;
+    for (int i = 1; i < obss->n; i++) {
+        if (fabs(obs[i].time - obs[i-1].time) > 1e-9 || obs[i].rcv != obs[i-1].rcv) nep++;
+    }
+
+    // Allocate all epochs at once
+    if (nep > epochs->nmax) {
+        obsEpoch_t *newEpoch = (obsEpoch_t *)realloc(epochs->epoch, nep * sizeof(obsEpoch_t));
+        if (!newEpoch) return 0;
+
+        epochs->epoch = newEpoch;
+        epochs->nmax = nep;
+    }
+
+    // Set epochs
+    obsEpoch_t *epoch = epochs->epoch;
+    epoch[0].time  = obs[0].time;
+    epoch[0].rcv   = obs[0].rcv;
+    epoch[0].first = 0;
+
+    for (int i = 1, j = 0; i < obss->n; i++) {
+        if (fabs(obs[i].time - epoch[j].time) <= 1e-9 && obs[i].rcv == epoch[j].rcv) continue;
+
+        epoch[j].count = i - epoch[j].first;
+        j++;
+        epoch[j].time  = obs[i].time;
+        epoch[j].rcv   = obs[i].rcv;
+        epoch[j].first = i;
+    }
+    epoch[nep - 1].count = obss->n - epoch[nep - 1].first;
+    epochs->n = nep;
+
+    return 1;
+}
+
+// Find observation epoch by time and receiver index (binary search)
+int FindObsEpoch(const obsEpochs_t *epochs, double time, int rcv, double tol)
+{
+    // Check if the observation epoch index structure is valid
+    if (!epochs || epochs->n <= 0 || tol < 0.0) return -1;
+
+    // First epoch not earlier than time - tol
+    int lo = 0, hi = epochs->n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (epochs->epoch[mid].time < time - tol) lo = mid + 1;
+        else hi = mid;
+    }
+
+    // Closest epoch of the receiver within tolerance
+    int idx = -1;
+    double dtmin = tol;
+    for (int i = lo; i < epochs->n && epochs->epoch[i].time <= time + tol; i++) {
+        if (epochs->epoch[i].rcv != rcv) continue;
+
+        double dt = fabs(epochs->epoch[i].time - time);
+        if (idx < 0 || dt < dtmin) {
+            idx = i;
+            dtmin = dt;
+        }
+    }
+
+    return idx;
+}
+
+// Get observation data of an observation epoch (no copy)
+const obs_t *GetObsEpoch(const obss_t *obss, const obsEpochs_t *epochs, int i, int *n)
+{
+    // Check if the structures and epoch index are valid
+    if (!obss || !epochs || i < 0 || i >= epochs->n) return NULL;
+
+    const obsEpoch_t *epoch = epochs->epoch + i;
+    if (epoch->first + epoch->count > obss->n) return NULL;
+
+    if (n) *n = epoch->count;
+
+    return obss->obs + epoch->first;
+}
+
+// Get observation data of next observation epoch (no copy)
+const obs_t *NextObsEpoch(const obss_t *obss, const obsEpochs_t *epochs, int *iter, int *n)
+{
+    // Check if the iterator is valid
+    if (!iter) return NULL;
+
+    const obs_t *obs = GetObsEpoch(obss, epochs, *iter, n);
+    if (obs) (*iter)++;
+
+    return obs;
+}
+
+// =============================================================================
+// Compact observation data functions
+// =============================================================================
+
+// Initialize compact observation data structure
+void InitObsPack(obsPack_t *pack)
+{
+    // Check if the compact observation data structure is valid
+    if (!pack) return;
+
+    // Initialize the compact observation data structure
+    pack->n = 0;
+    pack->size = pack->nmax = 0;
+    pack->data = NULL;
+    pack->time = 0.0;
+    pack->rcv = 0;
+}
+
+// Free compact observation data structure
+void FreeObsPack(obsPack_t *pack)
+{
+    // Check if the compact observation data structure is valid
+    if (!pack) return;
+
+    // Free the compact observation data structure
+    if (pack->data) {
+        free(pack->data);
+    }
+    InitObsPack(pack);
+}
+
+// Encode observation data and add to compact observation data
+int AddObsPack(obsPack_t *pack, const obs_t *obs)
+{
+    // Check if the structures are valid
+    if (!pack || !obs) return 0;
+
+    // Check if the encoded data may not fit
+    if (pack->nmax - pack->size < MAX_PACK_REC) {
+        size_t nnew = (pack->nmax == 0) ? 64 * MAX_PACK_REC : pack->nmax * 2;
+        unsigned char *newData = (unsigned char *)realloc(pack->data, nnew);
+        if (!newData) return 0;
+
+        pack->data = newData;
+        pack->nmax = nnew;
+    }
+
+    // Encode the observation data (time and receiver index only if changed)
+    int newtime = (pack->n == 0 || obs->time != pack->time);
+    int newrcv  = (pack->n == 0 || obs->rcv  != pack->rcv );
+    pack->size += EncodeObs(pack->data + pack->size, obs, newtime, newrcv);
+    pack->time = obs->time;
+    pack->rcv  = obs->rcv;
+    pack->n++;
+
+    return 1;
+}
+
+// Decode next observation data of compact observation data
+int NextObsPack(const obsPack_t *pack, size_t *pos, obs_t *obs)
+{
+    // Check if the structures are valid
+    if (!pack || !pos || !obs || *pos >= pack->size) return 0;
+
+    const unsigned char *p = pack->data + *pos, *end = pack->data + pack->size;
+    int64_t ival, refP = 0;
+    int n;
+
+    // Flags, time and receiver index
+    int flags = *p++;
+    double time = obs->time;
+    int rcv = obs->rcv;
+
+    if (flags & 1) {
+        if (end - p < (ptrdiff_t)sizeof(double)) return 0;
+        memcpy(&time, p, sizeof(double));
+        p += sizeof(double);
+    }
+    if (flags & 2) {
+        if (!(n = GetVarint(p, end, &ival))) return 0;
+        rcv = (int)ival;
+        p += n;
+    }
+    memset(obs, 0, sizeof(obs_t));
+    obs->time = time;
+    obs->rcv = rcv;
+
+    double *val[4] = {obs->P, obs->L, obs->D, obs->SNR};
+
+    // Satellite index
+    if (!(n = GetVarint(p, end, &ival))) return 0;
+    obs->sat = (int)ival;
+    p += n;
+
+    // Frequencies with data
+    for (int f = 0; f < NFREQ; f++) {
+
+        if (!(flags & (4 << f))) continue;
+
+        if (!(n = GetVarint(p, end, &ival)) || p + n >= end) return 0;
+        obs->code[f] = (int)ival;
+        p += n;
+
+        int vmask = *p & 0x0F, lli = *p >> 4;
+        p++;
+        if (lli == 15) {
+            if (!(n = GetVarint(p, end, &ival))) return 0;
+            lli = (int)ival;
+            p += n;
         }
+        obs->LLI[f] = lli;
 
-        // Copy the observation data to the next position
-        if (n != i) {
-            obss->obs[n] = obss->obs[i];
+        for (int j = 0; j < 4; j++) {
+
+            if (!(vmask & (1 << j))) continue;
+
+            int64_t k = 0;
+            if (!(n = GetObsVal(p, end, j == 0 ? refP : 0, &val[j][f], &k))) return 0;
+            if (j == 0 && refP == 0) refP = k;
+            p += n;
         }
-        n++;
     }
+    *pos = (size_t)(p - pack->data);
 
-    // Update the number of observation data
-    obss->n = n;
+    return 1;
 }
 
+// Convert observation data set to compact observation data
+int Obss2Pack(const obss_t *obss, obsPack_t *pack)
+{
+    // Check if the structures are valid
+    if (!obss || !pack) return 0;
+
+    // Replace the previous compact data
+    pack->n = 0;
+    pack->size = 0;
+
+    for (int i = 0; i < obss->n; i++) {
+        if (!AddObsPack(pack, obss->obs + i)) return 0;
+    }
+    return 1;
+}
+
+// Convert compact observation data to observation data set
+int Pack2Obss(const obsPack_t *pack, obss_t *obss)
+{
+    // Check if the structures are valid
+    if (!pack || !obss) return 0;
+
+    // Allocate all records at once
+    if (pack->n > obss->nmax && !ResizeObss(obss, pack->n)) return 0;
+
+    // Decode records in order
+    obs_t obs = {0};
+    size_t pos = 0;
+    int n = 0;
+
+    while (n < pack->n && NextObsPack(pack, &pos, &obs)) {
+        obss->obs[n++] = obs;
+    }
+    obss->n = n;
+
+    return n == pack->n;
+}
 
 // =============================================================================
 // Observation code conversion functions
@@ -34,6 +34,8 @@ void SetDefaultOpt(opt_t *opt) {
 
     opt->ts             = 0.0;
     opt->te             = 0.0;
+    opt->ti             = 0.0;
+    opt->obscache       = 0;
 
     opt->err            = 3E-3;
     opt->errratio       = 100.0;
@@ -55,18 +57,19 @@ void SetDefaultOpt(opt_t *opt) {
     opt->maxgdop        = 30.0;
 
     for (int i = 0; i < NSAT; i++) opt->exsats[i] = 0;
+    for (int i = 0; i < NSAT; i++) opt->rdexsats[i] = 0;
 
     // Set default excluded satellites for BeiDou GEO (C01-C05, C59-C62)
     int sat;
     if (Str2Sys('C') > 0) {
-        if ((sat = Str2Sat((satStr_t){.str = "C01"})) > 0) opt->exsats[sat] = 1; // BDS 2 GEO
-        if ((sat = Str2Sat((satStr_t){.str = "C02"})) > 0) opt->exsats[sat] = 1; // BDS 2 GEO
-        if ((sat = Str2Sat((satStr_t){.str = "C03"})) > 0) opt->exsats[sat] = 1; // BDS 2 GEO
-        if ((sat = Str2Sat((satStr_t){.str = "C04"})) > 0) opt->exsats[sat] = 1; // BDS 2 GEO
-        if ((sat = Str2Sat((satStr_t){.str = "C05"})) > 0) opt->exsats[sat] = 1; // BDS 2 GEO
-        if ((sat = Str2Sat((satStr_t){.str = "C59"})) > 0) opt->exsats[sat] = 1; // BDS 3 GEO
-        if ((sat = Str2Sat((satStr_t){.str = "C60"})) > 0) opt->exsats[sat] = 1; // BDS 3 GEO
-        if ((sat = Str2Sat((satStr_t){.str = "C61"})) > 0) opt->exsats[sat] = 1; // BDS 3 GEO
-        if ((sat = Str2Sat((satStr_t){.str = "C62"})) > 0) opt->exsats[sat] = 1; // BDS 3 GEO
+        if ((sat = Str2Sat((satStr_t){.str = "C01"})) > 0) opt->exsats[sat - 1] = 1; // BDS 2 GEO
+        if ((sat = Str2Sat((satStr_t){.str = "C02"})) > 0) opt->exsats[sat - 1] = 1; // BDS 2 GEO
+        if ((sat = Str2Sat((satStr_t){.str = "C03"})) > 0) opt->exsats[sat - 1] = 1; // BDS 2 GEO
+        if ((sat = Str2Sat((satStr_t){.str = "C04"})) > 0) opt->exsats[sat - 1] = 1; // BDS 2 GEO
+        if ((sat = Str2Sat((satStr_t){.str = "C05"})) > 0) opt->exsats[sat - 1] = 1; // BDS 2 GEO
+        if ((sat = Str2Sat((satStr_t){.str = "C59"})) > 0) opt->exsats[sat - 1] = 1; // BDS 3 GEO
+        if ((sat = Str2Sat((satStr_t){.str = "C60"})) > 0) opt->exsats[sat - 1] = 1; // BDS 3 GEO
+        if ((sat = Str2Sat((satStr_t){.str = "C61"})) > 0) opt->exsats[sat - 1] = 1; // BDS 3 GEO
+        if ((sat = Str2Sat((satStr_t){.str = "C62"})) > 0) opt->exsats[sat - 1] = 1; // BDS 3 GEO
     }
 }
@@ -5,50 +5,94 @@
 // Yongrae Jo, 0727ggame@sju.ac.kr
 // =============================================================================
 
+// Feature test macro (POSIX nanosleep with strict C99)
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 // Standard library
 #include <math.h>                       // for round, floor, fmod
-#include <string.h>                     // for strlen, strcpy, strncmp
-#include <stdlib.h>                     // for free
+#include <string.h>                     // for strlen, strcpy, strncmp, memmove
+#include <stdlib.h>                     // for malloc, realloc, free
 #include <stdio.h>                      // for sscanf, sprintf
+#include <stdint.h>                     // for uint64_t
+#ifdef _WIN32
+#include <windows.h>                    // for Sleep
+#else
+#include <pthread.h>                    // for pthread_create, pthread_join
+#include <time.h>                       // for nanosleep, struct timespec
+#endif
 
 // GNSS library
 #include "rinex.h"
 #include "files.h"                      // for buffer_t, GetLine
 #include "common.h"                     // for Sys2Str
-#include "obs.h"                        // for Str2Code, Code2Fidx, AddObs, SortObss
+#include "obs.h"                        // for Str2Code, Code2Fidx, AddObs, ReserveObss, SortObss
 #include "ephemeris.h"                  // for AddEph, SortEph
+#include "decomp.h"                     // for OpenDecomp, ReadDecomp, ResumeDecomp, CloseDecomp
 
 // =============================================================================
 // Macros
 // =============================================================================
 
 #define MAX_OBSTYPE 32                   // Number of observation types
+#define RNX_CHUNK_SIZE (1 << 20)         // Initial chunk size of observation stream [bytes]
+#define MAX_EXACT_MANT (1ULL << 53)      // Maximum mantissa exactly representable in double
+#define MAX_EXACT_POW10 22               // Maximum power of 10 exactly representable in double
+#define MAX_RNX_THREAD 64                // Maximum number of observation parsing threads
+#define RNX_DTTOL 0.005                  // Tolerance of epoch time for read filter [s]
+#define RNX_POLL_MIN 0.01                // Minimum poll interval of followed file [s]
 
 // =============================================================================
 // Static type definitions
 // =============================================================================
 
+typedef struct rnxObsType {                 // RINEX observation type dispatch entry
+    char kind;                              // Observation kind ('C','L','D','S', '\0': skip)
+    int  code;                              // Observation code
+    int  fidx;                              // Frequency index
+} rnxObsType_t;
+
 typedef struct rnxObsHeader {               // RINEX observation header structure
-    double ver;                             // RINEX version number
-    char   sys;                             // System string
-    char   obsType[NSYS][MAX_OBSTYPE][4];   // Observation types
-    int    nObsType[NSYS];                  // Number of observation types per system
-    sta_t  sta;                             // Station information
+    double       ver;                           // RINEX version number
+    char         sys;                           // System string
+    char         obsType[NSYS][MAX_OBSTYPE][4]; // Observation types
+    int          nObsType[NSYS];                // Number of observation types per system
+    rnxObsType_t type[NSYS][MAX_OBSTYPE];       // Observation type dispatch table
+    sta_t        sta;                           // Station information
 } rnxObsHeader_t;
 
-typedef struct rnxObsBody {                 // RINEX observation body structure
-    cal_t    cal;                           // Observation epoch time
-    satStr_t satStr;                        // Satellite ID string
-    double   obs[MAX_OBSTYPE];              // Observation data
-    int      lli[MAX_OBSTYPE];              // Loss of lock indicator
-} rnxObsBody_t;
-
 typedef struct rnxObs {                     // RINEX observation structure
     rnxObsHeader_t header;                  // RINEX observation header
-    rnxObsBody_t   *body;                   // RINEX observation data body
-    int            n;                       // Number of observation data
+    const opt_t    *opt;                    // Read filter (ts, te, ti, rdexsats) (NULL: none)
 } rnxObs_t;
 
+struct rnxObsStream {                       // RINEX observation stream structure (rinex.h)
+    decomp_t *dec;                          // Decompression stream of file
+    rnxObs_t rnxObs;                        // RINEX observation header
+    buffer_t buffer;                        // Chunk buffer (complete lines only)
+    size_t   cap;                           // Chunk buffer capacity [bytes]
+    size_t   pos;                           // Start of unparsed data in chunk [bytes]
+    int      eof;                           // End of file flag
+    int      follow;                        // Follow mode (file may grow, no end of file)
+    int      idle;                          // No more data appended yet (follow mode)
+    int      idx;                           // Next observation of chunk data
+    int      rcv;                           // Receiver index
+    obss_t   obs;                           // Chunk observation data
+    obss_t   epoch;                         // Current epoch observation data
+};
+
+#ifndef _WIN32
+typedef struct rnxObsSlice {                // RINEX observation body slice (parallel parsing)
+    buffer_t       view;                    // File buffer view ending at slice end line
+    const rnxObs_t *rnxObs;                 // RINEX observation header
+    size_t         start;                   // Slice start line
+    int            rcv;                     // Receiver index
+    obss_t         obs;                     // Slice observation data
+    int            info;                    // Parse result (1: success, 0: failure)
+} rnxObsSlice_t;
+#endif
+
 typedef struct rnxNavHeader {               // RINEX navigation header structure
     double ver;                             // RINEX version number
     char   sys;                             // System string
@@ -216,6 +260,108 @@ static void Deblank(char *str, const char *line, int maxlen)
     }
 }
 
+// Convert fixed-width numeric field to double (1: value, 0: blank or invalid field)
+//
+// The field is line[pos, pos + width) clipped to len; Fortran 'D' exponents are
+// accepted. Values with mantissa < 2^53 and |decimal exponent| <= 22 are
+// computed as one correctly rounded multiply or divide (same result as
+// strtod); other fields fall back to strtod.
+static int Str2Num(const char *line, int len, int pos, int width, double *val)
+{
+    static const double pow10[MAX_EXACT_POW10 + 1] = {
+        1E0,  1E1,  1E2,  1E3,  1E4,  1E5,  1E6,  1E7,  1E8,  1E9,  1E10, 1E11,
+        1E12, 1E13, 1E14, 1E15, 1E16, 1E17, 1E18, 1E19, 1E20, 1E21, 1E22
+    };
+
+    *val = 0.0;
+    int end = (pos + width < len) ? pos + width : len;
+
+    // Skip leading blanks (blank field is missing)
+    int i = pos;
+    while (i < end && line[i] == ' ') i++;
+    if (i >= end) return 0;
+    int start = i;
+
+    // Sign
+    int neg = 0;
+    if (line[i] == '-' || line[i] == '+') neg = (line[i++] == '-');
+
+    // Mantissa digits and decimal point
+    uint64_t mant = 0;
+    int exp10 = 0, ndig = 0, over = 0;
+    for (int frac = 0; i < end; i++) {
+        if (line[i] == '.' && !frac) {
+            frac = 1;
+            continue;
+        }
+        if (line[i] < '0' || line[i] > '9') break;
+        if (mant < MAX_EXACT_MANT) mant = mant * 10 + (uint64_t)(line[i] - '0');
+        else over = 1;
+        if (frac) exp10--;
+        ndig++;
+    }
+
+    // Exponent (E or D)
+    if (ndig > 0 && i < end && (line[i] == 'E' || line[i] == 'e' || line[i] == 'D' || line[i] == 'd')) {
+        int eneg = 0, e = 0, edig = 0;
+        if (++i < end && (line[i] == '-' || line[i] == '+')) eneg = (line[i++] == '-');
+        for (; i < end && line[i] >= '0' && line[i] <= '9' && e < 1000; i++, edig++) {
+            e = e * 10 + (line[i] - '0');
+        }
+        if (edig == 0) over = 1;
+        exp10 += eneg ? -e : e;
+    }
+
+    // Trailing blanks
+    while (i < end && line[i] == ' ') i++;
+
+    // Exact conversion
+    if (ndig > 0 && i >= end && !over && mant <= MAX_EXACT_MANT &&
+        exp10 >= -MAX_EXACT_POW10 && exp10 <= MAX_EXACT_POW10) {
+        double v = (double)mant;
+        v = (exp10 < 0) ? v / pow10[-exp10] : v * pow10[exp10];
+        *val = neg ? -v : v;
+        return 1;
+    }
+
+    // Fallback to strtod (D exponent replaced with E)
+    char field[64], *endp;
+    int n = (end - start < 63) ? end - start : 63;
+    for (int k = 0; k < n; k++) {
+        field[k] = (line[start + k] == 'D' || line[start + k] == 'd') ? 'E' : line[start + k];
+    }
+    field[n] = '\0';
+    *val = strtod(field, &endp);
+
+    return endp != field;
+}
+
+// Convert fixed-width integer field to int (1: value, 0: blank or invalid field)
+static int Str2Int(const char *line, int len, int pos, int width, int *val)
+{
+    *val = 0;
+    int end = (pos + width < len) ? pos + width : len;
+
+    // Skip leading blanks
+    int i = pos;
+    while (i < end && line[i] == ' ') i++;
+    if (i >= end) return 0;
+
+    // Sign and digits
+    int neg = 0, ndig = 0, v = 0;
+    if (line[i] == '-' || line[i] == '+') neg = (line[i++] == '-');
+    for (; i < end && line[i] >= '0' && line[i] <= '9'; i++, ndig++) {
+        v = v * 10 + (line[i] - '0');
+    }
+
+    // Trailing blanks
+    while (i < end && line[i] == ' ') i++;
+    if (ndig == 0 || i < end) return 0;
+
+    *val = neg ? -v : v;
+    return 1;
+}
+
 // Initialize RINEX observation structure (1: success, 0: failure)
 static int InitRnxObs(rnxObs_t *rnxObs)
 {
@@ -235,25 +381,12 @@ static int InitRnxObs(rnxObs_t *rnxObs)
     // Initialize station information
     memset(&rnxObs->header.sta, 0, sizeof(sta_t));
 
-    // Initialize RINEX observation data body
-    rnxObs->body = NULL;
-    rnxObs->n = 0;
+    // No read filter
+    rnxObs->opt = NULL;
 
     return 1;
 }
 
-// Free RINEX observation structure
-static void FreeRnxObs(rnxObs_t *rnxObs)
-{
-    if (!rnxObs) return;
-
-    if (rnxObs->body) {
-        free(rnxObs->body);
-        rnxObs->body = NULL;
-    }
-    rnxObs->n = 0;
-}
-
 // Initialize RINEX navigation structure (1: success, 0: failure)
 static int InitRnxNav(rnxNav_t *rnxNav)
 {
@@ -288,12 +421,51 @@ static void FreeRnxNav(rnxNav_t *rnxNav)
     rnxNav->n = 0;
 }
 
+// Set observation type dispatch table from header observation types
+//
+// Kind, code and frequency index depend only on the header and system, so they
+// are resolved once per file instead of once per record.
+static void SetRnxObsTypes(rnxObsHeader_t *header)
+{
+    for (int sys = 1; sys <= NSYS; sys++) {
+        for (int t = 0; t < MAX_OBSTYPE; t++) {
+
+            rnxObsType_t *type = &header->type[sys - 1][t];
+            type->kind = '\0';
+            type->code = 0;
+            type->fidx = 0;
+
+            // Get observation type string (e.g., "C1C", "L1C", "D1C", "S1C")
+            const char *obsTypeStr = header->obsType[sys - 1][t];
+            if (t >= header->nObsType[sys - 1] || strlen(obsTypeStr) < 3) continue;
+
+            // Check observation kind
+            char kind = obsTypeStr[0];
+            if (kind != 'C' && kind != 'L' && kind != 'D' && kind != 'S') continue;
+
+            // Convert to observation code ("L" + frequency and attribute)
+            codeStr_t codeStr;
+            sprintf(codeStr.str, "L%.2s", obsTypeStr + 1);
+            int code = Str2Code(codeStr);
+            if (code <= 0) continue;
+
+            // Get frequency index for this code
+            int fidx = Code2Fidx(sys, code);
+            if (fidx <= 0) continue;
+
+            type->kind = kind;
+            type->code = code;
+            type->fidx = fidx;
+        }
+    }
+}
+
 // Read RINEX observation file header (1: success, 0: failure)
 static int ReadRnxObsHeader(const buffer_t *buffer, rnxObs_t *rnxObs)
 {
     if (!buffer || !rnxObs) return 0;
 
-    char *line, type2[3], type3[4];
+    char *line, type2[3], type3[4], label[61];
     int len, endFlag = 0, ntype;
     size_t l = 0;
     double ver, pos[3], hen[3];
@@ -307,7 +479,7 @@ static int ReadRnxObsHeader(const buffer_t *buffer, rnxObs_t *rnxObs)
         if (LineContains(line, len, "RINEX VERSION / TYPE", 60)) {
 
             // Set version and system
-            if (sscanf(line, "%lf", &ver) != 1) return 0;
+            if (!Str2Num(line, len, 0, 9, &ver)) return 0;
             rnxObs->header.ver = ver;
             rnxObs->header.sys = line[40];
         }
@@ -331,8 +503,9 @@ static int ReadRnxObsHeader(const buffer_t *buffer, rnxObs_t *rnxObs)
         }
         else if (LineContains(line, len, "APPROX POSITION XYZ", 60)) {
 
-            // Set approximate position
-            if (sscanf(line, "%lf %lf %lf", pos, pos + 1, pos + 2) == 3) {
+            // Set approximate position (free format up to the label)
+            Deblank(label, line, 60);
+            if (sscanf(label, "%lf %lf %lf", pos, pos + 1, pos + 2) == 3) {
                 rnxObs->header.sta.pos[0] = pos[0];
                 rnxObs->header.sta.pos[1] = pos[1];
                 rnxObs->header.sta.pos[2] = pos[2];
@@ -340,8 +513,9 @@ static int ReadRnxObsHeader(const buffer_t *buffer, rnxObs_t *rnxObs)
         }
         else if (LineContains(line, len, "ANTENNA: DELTA H/E/N", 60)) {
 
-            // Set antenna delta
-            if (sscanf(line, "%lf %lf %lf", hen, hen + 1, hen + 2) == 3) {
+            // Set antenna delta (free format up to the label)
+            Deblank(label, line, 60);
+            if (sscanf(label, "%lf %lf %lf", hen, hen + 1, hen + 2) == 3) {
                 rnxObs->header.sta.del[0] = hen[1]; // East
                 rnxObs->header.sta.del[1] = hen[2]; // North
                 rnxObs->header.sta.del[2] = hen[0]; // Up
@@ -350,7 +524,7 @@ static int ReadRnxObsHeader(const buffer_t *buffer, rnxObs_t *rnxObs)
         else if (LineContains(line, len, "# / TYPES OF OBSERV", 60)) {
 
             // Set number of observation types
-            if (sscanf(line, "%d", &ntype) != 1 || ntype <= 0) continue;
+            if (!Str2Int(line, len, 0, 6, &ntype) || ntype <= 0) continue;
             if (ntype > MAX_OBSTYPE) ntype = MAX_OBSTYPE;
 
             // Set number of observation types for all systems
@@ -398,7 +572,7 @@ static int ReadRnxObsHeader(const buffer_t *buffer, rnxObs_t *rnxObs)
             int sysidx = Str2Sys(sys);
 
             // Set number of observation types
-            if (sscanf(line + 3, "%d", &ntype) != 1 || ntype <= 0 || sysidx <= 0) continue;
+            if (!Str2Int(line, len, 3, 3, &ntype) || ntype <= 0 || sysidx <= 0) continue;
             if (ntype > MAX_OBSTYPE) ntype = MAX_OBSTYPE;
 
             // Set number of observation types for this system
@@ -441,74 +615,137 @@ static int ReadRnxObsHeader(const buffer_t *buffer, rnxObs_t *rnxObs)
         }
     }
 
+    // Set observation type dispatch table
+    if (endFlag) SetRnxObsTypes(&rnxObs->header);
+
     return endFlag;
 }
 
-// Read RINEX v2 observation file body
-static int ReadRnxObsBodyV2(const buffer_t *buffer, rnxObs_t *rnxObs, size_t startLine)
+// Sort observation data of one epoch (obs[i0, n)) by satellite
+//
+// Records of an epoch share time and receiver, and files list them nearly in
+// satellite order, so insertion sort is a single check per record in practice.
+static void SortRnxObsEpoch(obss_t *obs, int i0)
 {
-    if (!buffer || !rnxObs) return 0;
+    for (int i = i0 + 1; i < obs->n; i++) {
 
-    int len, nepoch = 0, total = 0;
-    size_t l;
-    char *line, *satline, *obsline;
-    satStr_t satid[NSAT]; // Satellite ID strings
+        if (obs->obs[i].sat >= obs->obs[i - 1].sat) continue;
 
-    // Maximum number of observation types
-    int ntype = 0;
-    for (int sys = 0; sys < NSYS; sys++) {
-        if (rnxObs->header.nObsType[sys] > ntype) {
-            ntype = rnxObs->header.nObsType[sys];
-        }
+        obs_t tmp = obs->obs[i];
+        int j = i;
+        for (; j > i0 && obs->obs[j - 1].sat > tmp.sat; j--) obs->obs[j] = obs->obs[j - 1];
+        obs->obs[j] = tmp;
     }
+}
 
-    // Number of lines per satellite
-    int nlps = (ntype + 4) / 5;
+// Scatter observation fields of a record line by dispatch table
+// (1: valid data found, 0: no valid data)
+//
+// Fields of types [t0, t1) are 16-character (F14.3, I1, I1) fields starting at
+// column pos of the line. Blank, invalid and zero fields are missing.
+static int ScanRnxObsFields(obs_t *newObs, const rnxObsType_t *type, const char *line,
+                            int len, int pos, int t0, int t1)
+{
+    int validFlag = 0;
 
-    // First pass: count epochs and total observations
-    for (l = startLine; l < buffer->nline; l++) {
+    for (int t = t0; t < t1 && t < MAX_OBSTYPE; t++, pos += 16) {
 
-        // Get line from buffer
-        if (!(line = GetLine(buffer, l, &len))) return 0;
+        if (pos >= len) break;
 
-        // Skip comment lines
-        if (LineContains(line, len, "COMMENT", 60)) continue;
+        // Skip unused type without parsing
+        if (!type[t].kind) continue;
 
-        // Check epoch line
-        // v2 format: position 29-31 has length > 29, position 3 is space, position 29 <= '1'
-        if (len < 30 || line[2] == ' ' || line[3] != ' ' || line[28] > '1') continue;
+        // Parse observation value
+        double val;
+        if (!Str2Num(line, len, pos, 14, &val) || val == 0.0) continue;
 
-        // Count epoch
-        nepoch++;
+        int f = type[t].fidx - 1;
+        newObs->code[f] = type[t].code;
 
-        // Get number of satellites in this epoch
-        int nsat;
-        if (sscanf(line + 29, "%d", &nsat) != 1 || nsat <= 0) continue;
-        total += nsat;
+        // Set observation based on type
+        switch (type[t].kind) {
+            case 'C':  // Pseudorange
+                newObs->P[f] = val;
+                break;
 
-        // Number of extended satellite list lines
-        int nles = (nsat + 11) / 12 - 1; // Ceiling division
+            case 'L':  // Carrier phase (LLI: 15th character)
+                newObs->L  [f] = val;
+                newObs->LLI[f] = (pos + 14 < len && line[pos + 14] >= '0' &&
+                                  line[pos + 14] <= '9') ? line[pos + 14] - '0' : 0;
+                break;
 
-        // Skip to next epoch
-        l += (nles + nsat * nlps);
+            case 'D':  // Doppler
+                newObs->D[f] = val;
+                break;
+
+            case 'S':  // Signal strength
+                newObs->SNR[f] = val;
+                break;
+        }
+        validFlag = 1;
     }
 
-    if (nepoch == 0) return 1; // No observations found
+    return validFlag;
+}
+
+// Check if read filter has a time window or interval
+static int RnxObsTimeFilter(const opt_t *opt)
+{
+    return opt && (opt->ts > 0.0 || opt->te > 0.0 || opt->ti > 0.0);
+}
 
-    // Allocate memory for observation body
-    rnxObs->body = (rnxObsBody_t *)malloc(total * sizeof(rnxObsBody_t));
-    if (!rnxObs->body) return 0;
-    rnxObs->n = total;
+// Check epoch time by read filter (1: read, 0: skip epoch block)
+static int ScreenRnxObsTime(const opt_t *opt, double time)
+{
+    if (!opt) return 1;
 
-    // Clear memory
-    memset(rnxObs->body, 0, total * sizeof(rnxObsBody_t));
+    // Time window [ts, te]
+    if (opt->ts > 0.0 && time < opt->ts - RNX_DTTOL) return 0;
+    if (opt->te > 0.0 && time > opt->te + RNX_DTTOL) return 0;
+
+    // Time interval
+    if (opt->ti > 0.0 && fmod(time + RNX_DTTOL, opt->ti) > 2.0 * RNX_DTTOL) return 0;
+
+    return 1;
+}
+
+// Check satellite by read filter (1: read, 0: excluded)
+static inline int ScreenRnxObsSat(const opt_t *opt, int sat)
+{
+    return !opt || !opt->rdexsats[sat - 1];
+}
+
+// Read RINEX v2 observation file body into observation data
+//
+// Single pass: the epoch time is converted once per epoch and the satellite
+// list once per epoch, and fields are scattered straight into observation data.
+static int ReadRnxObsBodyV2(const buffer_t *buffer, const rnxObs_t *rnxObs, size_t startLine,
+                            int rcvidx, obss_t *obs)
+{
+    if (!buffer || !rnxObs || !obs) return 0;
+
+    int len;
+    size_t l;
+    char *line, *satline, *obsline;
+    int sats[NSAT]; // Satellite numbers of epoch
+
+    // Maximum number of observation types
+    int ntype = 0;
+    for (int sys = 0; sys < NSYS; sys++) {
+        if (rnxObs->header.nObsType[sys] > ntype) {
+            ntype = rnxObs->header.nObsType[sys];
+        }
+    }
 
-    // Allocate record buffer (reused for all satellites)
-    char *record = (char *)malloc((ntype * 16 + 1) * sizeof(char));
-    if (!record) return 0;
+    // Number of lines per satellite
+    int nlps = (ntype + 4) / 5;
+
+    // Reserve observation data for the records (upper bound by number of lines,
+    // not if a time filter leaves only part of them)
+    if (buffer->nline > startLine && !RnxObsTimeFilter(rnxObs->opt)) {
+        ReserveObss(obs, obs->n + (int)((buffer->nline - startLine) / nlps));
+    }
 
-    // Second pass: parse actual observations
-    int oidx = 0;
     for (l = startLine; l < buffer->nline; l++) {
 
         // Get line from buffer
@@ -518,13 +755,14 @@ static int ReadRnxObsBodyV2(const buffer_t *buffer, rnxObs_t *rnxObs, size_t sta
         if (LineContains(line, len, "COMMENT", 60)) continue;
 
         // Check epoch line
+        // v2 format: position 29-31 has length > 29, position 3 is space, position 29 <= '1'
         if (len < 30 || line[2] == ' ' || line[3] != ' ' || line[28] > '1') continue;
 
         // Parse epoch time
         cal_t cal;
-        if (sscanf(line, "%2d %2d %2d %2d %2d %10lf",
-                  &cal.year, &cal.mon, &cal.day,
-                  &cal.hour, &cal.min, &cal.sec) != 6) continue;
+        if (!Str2Int(line, len,  0, 3, &cal.year) || !Str2Int(line, len,  3, 3, &cal.mon) ||
+            !Str2Int(line, len,  6, 3, &cal.day ) || !Str2Int(line, len,  9, 3, &cal.hour) ||
+            !Str2Int(line, len, 12, 3, &cal.min ) || !Str2Num(line, len, 15, 11, &cal.sec)) continue;
 
         // Convert 2-digit year to 4-digit year
         if (cal.year < 80) {
@@ -535,12 +773,23 @@ static int ReadRnxObsBodyV2(const buffer_t *buffer, rnxObs_t *rnxObs, size_t sta
 
         // Get number of satellites
         int nsat;
-        if (sscanf(line + 29, "%d", &nsat) != 1 || nsat <= 0) continue;
+        if (!Str2Int(line, len, 29, 3, &nsat) || nsat <= 0) continue;
 
         // Number of extended satellite list lines
         int nles = (nsat + 11) / 12 - 1;
 
+        // Convert epoch time to standard time
+        double time = Cal2Time(cal);
+
+        // Skip epoch block by read filter
+        if (!ScreenRnxObsTime(rnxObs->opt, time)) {
+            l += (nles + nsat * nlps);
+            continue;
+        }
+
         // Get satellite list
+        for (int s = 0; s < nsat && s < NSAT; s++) sats[s] = 0;
+
         for (int i = 0; i < nles + 1; i++) {
 
             // Get line from buffer
@@ -552,108 +801,76 @@ static int ReadRnxObsBodyV2(const buffer_t *buffer, rnxObs_t *rnxObs, size_t sta
 
             for (int j = 0; j < nsati; j++) {
                 int satidx = 12 * i + j;
-                if (satidx >= nsat) break;
+                if (satidx >= nsat || satidx >= NSAT) break;
 
                 if (len >= startCol + j * 3 + 3) {
 
                     // Extract satellite ID (3 characters)
-                    strncpy(satid[satidx].str, satline + startCol + j * 3, 3);
-                    satid[satidx].str[3] = '\0';
+                    satStr_t satStr;
+                    memcpy(satStr.str, satline + startCol + j * 3, 3);
+                    satStr.str[3] = '\0';
 
                     // Replace spaces with '0' for PRN
-                    if (satid[satidx].str[1] == ' ') satid[satidx].str[1] = '0';
-                    if (satid[satidx].str[2] == ' ') satid[satidx].str[2] = '0';
+                    if (satStr.str[1] == ' ') satStr.str[1] = '0';
+                    if (satStr.str[2] == ' ') satStr.str[2] = '0';
+
+                    // Convert satellite ID to satellite number
+                    sats[satidx] = Str2Sat(satStr);
                 }
             }
         }
 
         // Parse observations for each satellite
-        for (int s = 0; s < nsat && oidx < total; s++) {
+        int i0 = obs->n;
+        for (int s = 0; s < nsat && s < NSAT; s++) {
 
-            // Set epoch time and satellite ID
-            rnxObs->body[oidx].cal = cal;
-            strncpy(rnxObs->body[oidx].satStr.str, satid[s].str, 3);
-            rnxObs->body[oidx].satStr.str[3] = '\0';
+            // Get satellite system
+            int prn, sys;
+            if (sats[s] <= 0 || (sys = Sat2Prn(sats[s], &prn)) <= 0 || sys > NSYS) continue;
 
-            // Initialize observation arrays
-            for (int k = 0; k < MAX_OBSTYPE; k++) {
-                rnxObs->body[oidx].obs[k] = 0.0;
-                rnxObs->body[oidx].lli[k] = 0;
-            }
+            // Skip excluded satellite
+            if (!ScreenRnxObsSat(rnxObs->opt, sats[s])) continue;
 
-            // Parse observation lines for this satellite
-            // Initialize record with default pattern
-            for (int t = 0; t < ntype; t++) {
-                strncpy(record + t * 16, "         0.00000", 16);
-            }
-            record[ntype * 16] = '\0';
+            // Initialize observation data
+            obs_t newObs;
+            memset(&newObs, 0, sizeof(obs_t));
+            newObs.time = time;
+            newObs.rcv  = rcvidx;
+            newObs.sat  = sats[s];
 
-            // Fill record with actual observation data
+            // Parse observation lines for this satellite (5 fields per line)
+            int validFlag = 0;
             for (int o = 0; o < nlps; o++) {
 
                 // Get observation line
                 if (!(obsline = GetLine(buffer, l + 1 + nles + s * nlps + o, &len))) continue;
 
-                // Copy observation data to record
-                int startPos = 80 * o;
-                int copyLen = len;
-                if (startPos + copyLen <= ntype * 16) {
-                    strncpy(record + startPos, obsline, copyLen);
-                }
-            }
-
-            // Replace empty fields into zeros
-            const char defaultField[17] = "         0.00000";
-            for (int i = 0; i < ntype * 16; i++) {
-                if (record[i] == ' ') {
-                    record[i] = defaultField[i % 16];
-                }
+                validFlag |= ScanRnxObsFields(&newObs, rnxObs->header.type[sys - 1], obsline,
+                                              len, 0, 5 * o, 5 * o + 5 < ntype ? 5 * o + 5 : ntype);
             }
 
-            // Parse observations from record using RINEX v2 16-character field format
-            for (int t = 0; t < ntype && t < MAX_OBSTYPE; t++) {
-
-                int fieldStart = t * 16;
-
-                // Parse observation value (first 14 characters of 16-char field)
-                char obsStr[15];
-                strncpy(obsStr, record + fieldStart, 14);
-                obsStr[14] = '\0';
-
-                // Convert string to float
-                rnxObs->body[oidx].obs[t] = strtod(obsStr, NULL);
-
-                // Parse LLI (15th character)
-                char lliChar = record[fieldStart + 14];
-                if (lliChar >= '0' && lliChar <= '9') {
-                    rnxObs->body[oidx].lli[t] = lliChar - '0';
-                } else {
-                    rnxObs->body[oidx].lli[t] = 0;
-                }
-            }
-
-            oidx++;
+            // Add observation data
+            if (validFlag && !AddObs(obs, &newObs)) return 0;
         }
+        SortRnxObsEpoch(obs, i0);
 
         // Skip observation lines
         l += (nles + nsat * nlps);
     }
 
-    // Free record buffer
-    free(record);
-
-    // Update actual number of parsed observations
-    rnxObs->n = oidx;
-
     return 1;
 }
 
-// Read RINEX v3 observation file body
-static int ReadRnxObsBodyV3(const buffer_t *buffer, rnxObs_t *rnxObs, size_t startLine)
+// Read RINEX v3 observation file body into observation data
+//
+// Single pass: the epoch time is converted once per epoch and the satellite ID
+// once per record, and fields are scattered straight into observation data.
+static int ReadRnxObsBodyV3(const buffer_t *buffer, const rnxObs_t *rnxObs, size_t startLine,
+                            int rcvidx, obss_t *obs)
 {
-    if (!buffer || !rnxObs) return 0;
+    if (!buffer || !rnxObs || !obs) return 0;
 
-    int len, nepoch = 0, total = 0;
+    int len;
     size_t l;
     char *line;
 
@@ -664,67 +881,54 @@ static int ReadRnxObsBodyV3(const buffer_t *buffer, rnxObs_t *rnxObs, size_t sta
             ntype = rnxObs->header.nObsType[sys];
         }
     }
+    if (ntype > MAX_OBSTYPE) ntype = MAX_OBSTYPE;
 
-    // First pass: count epochs and total observations
-    for (l = startLine; l < buffer->nline; l++) {
-
-        // Get line from buffer
-        if (!(line = GetLine(buffer, l, &len))) return 0;
-
-        // Skip comment lines
-        if (LineContains(line, len, "COMMENT", 60)) continue;
-
-        // Check epoch line (v3 format: starts with '>', length > 35)
-        if (len <= 35 || line[0] != '>') continue;
-
-        // Count epoch
-        nepoch++;
-
-        // Get number of satellites in this epoch
-        int nsat;
-        if (sscanf(line + 32, "%d", &nsat) != 1 || nsat <= 0) continue;
-        total += nsat;
-
-        // Skip satellite observation lines
-        l += nsat;
+    // Reserve observation data for the records (upper bound by number of lines,
+    // not if a time filter leaves only part of them)
+    if (buffer->nline > startLine && !RnxObsTimeFilter(rnxObs->opt)) {
+        ReserveObss(obs, obs->n + (int)(buffer->nline - startLine));
     }
 
-    if (nepoch == 0) return 1; // No observations found
-
-    // Allocate memory for observation body
-    rnxObs->body = (rnxObsBody_t *)malloc(total * sizeof(rnxObsBody_t));
-    if (!rnxObs->body) return 0;
-    rnxObs->n = total;
-
-    // Allocate record buffer (reused for all satellites)
-    char *record = (char *)malloc((ntype * 16 + 1) * sizeof(char));
-    if (!record) return 0;
-
-    // Second pass: parse actual observations
-    int oidx = 0;
+    // Parse epochs and observations
     for (l = startLine; l < buffer->nline; l++) {
 
         // Get line from buffer
-        if (!(line = GetLine(buffer, l, &len))) return 0;
+        if (!(line = GetLine(buffer, l, &len))) break;
 
-        // Skip comment lines
-        if (LineContains(line, len, "COMMENT", 60)) continue;
+        // Check epoch line (v3 format: starts with '>', length >= 35)
+        if (len < 35 || line[0] != '>') continue;
+
+        // Get number of satellites
+        int nsat;
+        if (!Str2Int(line, len, 32, 3, &nsat) || nsat <= 0) continue;
 
-        // Check epoch line (v3 format: starts with '>', length > 35)
-        if (len <= 35 || line[0] != '>') continue;
+        // Skip special records of event epochs (flag 2-5: header or comment lines)
+        if (line[31] > '1') {
+            l += nsat;
+            continue;
+        }
 
-        // Parse epoch time
+        // Parse epoch time (skip satellite lines if invalid)
         cal_t cal;
-        if (sscanf(line + 2, "%4d %2d %2d %2d %2d %10lf",
-                  &cal.year, &cal.mon, &cal.day,
-                  &cal.hour, &cal.min, &cal.sec) != 6) continue;
+        if (!Str2Int(line, len,  2, 4, &cal.year) || !Str2Int(line, len,  7, 2, &cal.mon) ||
+            !Str2Int(line, len, 10, 2, &cal.day ) || !Str2Int(line, len, 13, 2, &cal.hour) ||
+            !Str2Int(line, len, 16, 2, &cal.min ) || !Str2Num(line, len, 18, 11, &cal.sec)) {
+            l += nsat;
+            continue;
+        }
 
-        // Get number of satellites
-        int nsat;
-        if (sscanf(line + 32, "%d", &nsat) != 1 || nsat <= 0) continue;
+        // Convert epoch time to standard time
+        double time = Cal2Time(cal);
+
+        // Skip epoch block by read filter
+        if (!ScreenRnxObsTime(rnxObs->opt, time)) {
+            l += nsat;
+            continue;
+        }
 
         // Parse observations for each satellite
-        for (int s = 0; s < nsat && oidx < total; s++) {
+        int i0 = obs->n;
+        for (int s = 0; s < nsat; s++) {
 
             // Get satellite observation line
             char *obsline;
@@ -733,98 +937,53 @@ static int ReadRnxObsBodyV3(const buffer_t *buffer, rnxObs_t *rnxObs, size_t sta
             // Check minimum line length (satellite ID + some data)
             if (len < 3) continue;
 
-            // Set epoch time and satellite ID
-            rnxObs->body[oidx].cal = cal;
-            strncpy(rnxObs->body[oidx].satStr.str, obsline, 3);
-            rnxObs->body[oidx].satStr.str[3] = '\0';
+            // Convert satellite ID to satellite number
+            satStr_t satStr;
+            memcpy(satStr.str, obsline, 3);
+            satStr.str[3] = '\0';
 
-            // Initialize observation arrays
-            for (int k = 0; k < MAX_OBSTYPE; k++) {
-                rnxObs->body[oidx].obs[k] = 0.0;
-                rnxObs->body[oidx].lli[k] = 0;
-            }
+            int prn, sys, sat = Str2Sat(satStr);
+            if (sat <= 0 || (sys = Sat2Prn(sat, &prn)) <= 0 || sys > NSYS) continue;
 
-            // Initialize record with default pattern
-            for (int t = 0; t < ntype; t++) {
-                strncpy(record + t * 16, "         0.00000", 16);
-            }
-            record[ntype * 16] = '\0';
+            // Skip excluded satellite
+            if (!ScreenRnxObsSat(rnxObs->opt, sat)) continue;
 
-            // Copy observation data from line (starting from position 4)
-            if (len > 3) {
-                int dataLen = len - 3;
-                int copyLen = (dataLen < ntype * 16) ? dataLen : ntype * 16;
-                strncpy(record, obsline + 3, copyLen);
-            }
-
-            // Replace empty fields with zeros
-            const char defaultField[17] = "         0.00000";
-            for (int i = 0; i < ntype * 16; i++) {
-                if (record[i] == ' ') {
-                    record[i] = defaultField[i % 16];
-                }
-            }
-
-            // Validate record format (check for decimal points at expected positions)
+            // Validate record format (decimal point of non-blank fields)
             int validRecord = 1;
             for (int t = 0; t < ntype; t++) {
-                int decimalPos = t * 16 + 10;
-                if (decimalPos < ntype * 16 && record[decimalPos] != '.') {
+                int decimalPos = 3 + t * 16 + 10;
+                if (decimalPos >= len) break;
+                if (obsline[decimalPos] != '.' && obsline[decimalPos] != ' ') {
                     validRecord = 0;
                     break;
                 }
             }
-
-            if (!validRecord) {
-                oidx++;
-                continue;
-            }
-
-            // Parse observations from record using RINEX v3 16-character field format
-            for (int t = 0; t < ntype && t < MAX_OBSTYPE; t++) {
-
-                int fieldStart = t * 16;
-
-                // Parse observation value (first 14 characters of 16-char field)
-                char obsStr[15];
-                strncpy(obsStr, record + fieldStart, 14);
-                obsStr[14] = '\0';
-
-                // Convert string to float
-                rnxObs->body[oidx].obs[t] = strtod(obsStr, NULL);
-
-                // Parse LLI (15th character)
-                char lliChar = record[fieldStart + 14];
-                if (lliChar >= '0' && lliChar <= '9') {
-                    rnxObs->body[oidx].lli[t] = lliChar - '0';
-                } else {
-                    rnxObs->body[oidx].lli[t] = 0;
-                }
-            }
-
-            oidx++;
+            if (!validRecord) continue;
+
+            // Initialize observation data
+            obs_t newObs;
+            memset(&newObs, 0, sizeof(obs_t));
+            newObs.time = time;
+            newObs.rcv  = rcvidx;
+            newObs.sat  = sat;
+
+            // Parse observations and add observation data
+            if (!ScanRnxObsFields(&newObs, rnxObs->header.type[sys - 1], obsline, len, 3, 0,
+                                  ntype)) continue;
+            if (!AddObs(obs, &newObs)) return 0;
         }
+        SortRnxObsEpoch(obs, i0);
 
         // Skip satellite observation lines
         l += nsat;
     }
 
-    // Free record buffer
-    free(record);
-
-    // Update actual number of parsed observations
-    rnxObs->n = oidx;
-
     return 1;
 }
 
-// Read RINEX observation file body
-static int ReadRnxObsBody(const buffer_t *buffer, rnxObs_t *rnxObs)
+// First line of RINEX observation file body (return: line after "END OF HEADER")
+static size_t RnxObsBodyStart(const buffer_t *buffer)
 {
-    // Check if the parameters are valid
-    if (!buffer || !rnxObs) return 0;
-
-    // Initialize variables
     int len;
     size_t l;
     char *line;
@@ -833,141 +992,316 @@ static int ReadRnxObsBody(const buffer_t *buffer, rnxObs_t *rnxObs)
     for (l = 0; l < buffer->nline; l++) {
 
         // Get line from buffer
-        if (!(line = GetLine(buffer, l, &len))) return 0;
+        if (!(line = GetLine(buffer, l, &len))) break;
 
-        // Skip header lines and find "END OF HEADER"
-        if (LineContains(line, len, "END OF HEADER", 60)) {
-            l++;
-            break;
-        }
+        if (LineContains(line, len, "END OF HEADER", 60)) return l + 1;
     }
 
+    return l;
+}
+
+// Read RINEX observation file body into observation data (1: success, 0: failure)
+static int ReadRnxObsBody(const buffer_t *buffer, const rnxObs_t *rnxObs, int rcvidx,
+                          obss_t *obs)
+{
+    // Check if the parameters are valid
+    if (!buffer || !rnxObs || !obs) return 0;
+
+    // Skip header lines
+    size_t l = RnxObsBodyStart(buffer);
+
     // Parse observations based on RINEX version
     int ver = (int)rnxObs->header.ver;
 
     if (ver == 2) {
-        return ReadRnxObsBodyV2(buffer, rnxObs, l);
+        return ReadRnxObsBodyV2(buffer, rnxObs, l, rcvidx, obs);
     }
     else if (ver == 3) {
-        return ReadRnxObsBodyV3(buffer, rnxObs, l);
+        return ReadRnxObsBodyV3(buffer, rnxObs, l, rcvidx, obs);
     }
 
     return 0; // Unsupported version
 }
 
-// Add and arrange observation data to observation structure
-static int ArrangeObs(obss_t *obs, rnxObs_t *rnxObs, int rcvidx)
+// Number of lines of the epoch block starting at line (0: not an epoch line)
+static size_t RnxObsBlockLen(const rnxObs_t *rnxObs, const char *line, int len)
 {
-    // Check if the parameters are valid
-    if (!obs || !rnxObs) return 0;
+    // Skip comment lines
+    if (LineContains(line, len, "COMMENT", 60)) return 0;
 
-    // Check if the receiver index is valid
-    if (rcvidx <= 0 || rcvidx > NRCV) return 0;
+    int nsat;
+    if ((int)rnxObs->header.ver == 2) {
 
-    // Process each observation epoch
-    for (int i = 0; i < rnxObs->n; i++) {
+        // Check epoch line (same rule as ReadRnxObsBodyV2)
+        if (len < 30 || line[2] == ' ' || line[3] != ' ' || line[28] > '1') return 0;
+        if (!Str2Int(line, len, 29, 3, &nsat) || nsat <= 0) return 1;
 
-        // Convert satellite ID to satellite number
-        int sat = Str2Sat(rnxObs->body[i].satStr);
-        if (sat <= 0) continue;
+        // Maximum number of observation types
+        int ntype = 0;
+        for (int sys = 0; sys < NSYS; sys++) {
+            if (rnxObs->header.nObsType[sys] > ntype) ntype = rnxObs->header.nObsType[sys];
+        }
+        int nlps = (ntype + 4) / 5;
+        int nles = (nsat + 11) / 12 - 1;
 
-        // Get satellite system
-        int prn;
-        int sys = Sat2Prn(sat, &prn);
-        if (sys <= 0 || sys > NSYS) continue;
+        return (size_t)(1 + nles + nsat * nlps);
+    }
 
-        // Convert calendar time to standard time
-        double time = Cal2Time(rnxObs->body[i].cal);
+    // Check epoch line (same rule as ReadRnxObsBodyV3)
+    if (len < 35 || line[0] != '>') return 0;
+    if (!Str2Int(line, len, 32, 3, &nsat) || nsat <= 0) return 1;
 
-        // Get number of observation types for this system
-        int nObsType = rnxObs->header.nObsType[sys - 1];
-        if (nObsType <= 0) continue;
+    return (size_t)(1 + nsat);
+}
 
-        // Create observation structure
-        obs_t newObs;
-        memset(&newObs, 0, sizeof(obs_t));
+// Read next chunk of observation stream (1: success, 0: failure)
+//
+// Unparsed data is moved to the front of the chunk and the rest is filled from
+// the file. The chunk is doubled if the unparsed data already fills it. Only
+// complete lines are indexed until the end of file. In follow mode, the end of
+// file only marks the stream idle and is never reached, so a partly written
+// line or epoch block stays in the chunk until the rest is appended.
+static int FillRnxObsStream(rnxObsStream_t *stream)
+{
+    buffer_t *buffer = &stream->buffer;
+
+    // Move unparsed data to the front
+    size_t size = buffer->size - stream->pos;
+    if (size > 0 && stream->pos > 0) memmove(buffer->buff, buffer->buff + stream->pos, size);
+    stream->pos = 0;
+
+    // Grow chunk if full
+    if (size >= stream->cap) {
+        char *buff = (char*)realloc(buffer->buff, stream->cap * 2 + 1);
+        if (!buff) return 0;
+        buffer->buff = buff;
+        stream->cap *= 2;
+    }
 
-        // Set common fields (time, sat, rcvidx)
-        newObs.time = time;
-        newObs.rcv = rcvidx;
-        newObs.sat = sat;
+    // Fill chunk from file
+    size_t nread = ReadDecomp(stream->dec, buffer->buff + size, stream->cap - size);
+    stream->idle = 0;
+    if (nread < stream->cap - size) {
+        if (ErrorDecomp(stream->dec)) return 0;
+        if (!stream->follow) stream->eof = 1;
+        else if (!ResumeDecomp(stream->dec)) return 0;
+        else stream->idle = 1;
+    }
+    buffer->size = size + nread;
+    buffer->buff[buffer->size] = '\0';
 
-        // Initialize valid flag
-        int validFlag = 0;
+    if (buffer->size == 0) {
+        buffer->nline = 0;
+        return 1;
+    }
 
-        // Process each observation type for this system
-        for (int t = 0; t < nObsType && t < MAX_OBSTYPE; t++) {
+    // Index lines (drop incomplete last line until end of file)
+    if (!IndexBuff(buffer)) return 0;
+    if (!stream->eof && buffer->buff[buffer->size - 1] != '\n') buffer->nline--;
 
-            // Get observation type string (e.g., "C1C", "L1C", "D1C", "S1C")
-            char *obsTypeStr = rnxObs->header.obsType[sys - 1][t];
-            if (strlen(obsTypeStr) < 3) continue;
+    return 1;
+}
 
-            // Extract frequency and attribute (e.g., "1C" from "C1C")
-            char freqAttr[3];
-            strncpy(freqAttr, obsTypeStr + 1, 2);
-            freqAttr[2] = '\0';
+// Offset of line l in chunk, including dropped incomplete line (return: offset [bytes])
+static size_t RnxObsStreamPos(const rnxObsStream_t *stream, size_t l)
+{
+    const buffer_t *buffer = &stream->buffer;
+    int part = !stream->eof && buffer->size > 0 && buffer->buff[buffer->size - 1] != '\n';
 
-            // Convert to observation code
-            codeStr_t codeStr;
-            sprintf(codeStr.str, "L%s", freqAttr);  // Start with "L" prefix for code conversion
-            int code = Str2Code(codeStr);
-            if (code <= 0) continue;
+    return (l < buffer->nline || part) ? buffer->lineinfo[l].start : buffer->size;
+}
 
-            // Get frequency index for this code
-            int fidx = Code2Fidx(sys, code);
-            if (fidx <= 0) continue;
+// Free observation stream
+static void FreeRnxObsStream(rnxObsStream_t *stream)
+{
+    if (stream->dec) CloseDecomp(stream->dec);
+    stream->dec = NULL;
+    FreeBuff(&stream->buffer);
+    FreeObss(&stream->obs);
+    FreeObss(&stream->epoch);
+}
 
-            // Get observation value
-            double obsValue = rnxObs->body[i].obs[t];
-            int lliValue = rnxObs->body[i].lli[t];
+// Open observation stream and read header (1: success, 0: failure)
+//
+// The header must be complete in follow mode.
+static int OpenRnxObsStream(rnxObsStream_t *stream, const char *filename, int follow)
+{
+    // Initialize stream
+    stream->dec = NULL;
+    stream->cap = RNX_CHUNK_SIZE;
+    stream->pos = 0;
+    stream->eof = 0;
+    stream->follow = follow;
+    stream->idle = 0;
+    stream->idx = 0;
+    stream->rcv = 0;
+    InitObss(&stream->obs);
+    InitObss(&stream->epoch);
+    if (!InitRnxObs(&stream->rnxObs) || !InitBuff(&stream->buffer)) return 0;
+
+    if (!(stream->buffer.buff = (char*)malloc(stream->cap + 1))) return 0;
+    if (!(stream->dec = OpenDecomp(filename))) return 0;
+
+    // Read chunks until the header is complete
+    size_t l = 0;
+    for (int endFlag = 0; !endFlag; ) {
+        if (!FillRnxObsStream(stream)) return 0;
 
-            // Skip if observation is zero (invalid)
-            if (obsValue == 0.0) continue;
+        for (l = 0; l < stream->buffer.nline && !endFlag; l++) {
+            int len;
+            char *line = GetLine(&stream->buffer, l, &len);
+            endFlag = LineContains(line, len, "END OF HEADER", 60);
+        }
+        if (!endFlag && (stream->eof || stream->idle)) return 0;
+    }
 
-            // Set observation based on type
-            char obsType = obsTypeStr[0];
-            switch (obsType) {
-                case 'C':  // Pseudorange
-                    newObs.code[fidx - 1] = code;
-                    newObs.P   [fidx - 1] = obsValue;
-                    validFlag = 1;  // Set valid flag
-                    break;
+    // Read RINEX observation header
+    if (!ReadRnxObsHeader(&stream->buffer, &stream->rnxObs)) return 0;
 
-                case 'L':  // Carrier phase
-                    newObs.code[fidx - 1] = code;
-                    newObs.L   [fidx - 1] = obsValue;
-                    newObs.LLI [fidx - 1] = lliValue;
-                    validFlag = 1;  // Set valid flag
-                    break;
+    // Check RINEX version
+    int ver = (int)stream->rnxObs.header.ver;
+    if (ver < 2 || ver > 3) return 0;
 
-                case 'D':  // Doppler
-                    newObs.code[fidx - 1] = code;
-                    newObs.D   [fidx - 1] = obsValue;
-                    validFlag = 1;  // Set valid flag
-                    break;
+    // Body starts after "END OF HEADER"
+    stream->pos = RnxObsStreamPos(stream, l);
+    return 1;
+}
 
-                case 'S':  // Signal strength
-                    newObs.code[fidx - 1] = code;
-                    newObs.SNR [fidx - 1] = obsValue;
-                    validFlag = 1;  // Set valid flag
-                    break;
+// Parse complete epoch blocks of next chunk into observation data (1: success, 0: failure)
+//
+// Returns without adding observation data at the end of file, or in follow
+// mode if no complete epoch block has been appended yet.
+static int ReadRnxObsStreamChunk(rnxObsStream_t *stream, obss_t *obs)
+{
+    const rnxObs_t *rnxObs = &stream->rnxObs;
+    int n0 = obs->n;
+
+    while (1) {
+
+        // Read next chunk if all lines are parsed
+        if (!FillRnxObsStream(stream)) return 0;
+
+        // Find end of last complete epoch block
+        buffer_t *buffer = &stream->buffer;
+        size_t l = 0, nline = buffer->nline;
+        while (l < nline) {
+            int len;
+            char *line = GetLine(buffer, l, &len);
+            size_t nblk = RnxObsBlockLen(rnxObs, line, len);
+            if (nblk == 0) nblk = 1;
+            if (l + nblk > nline && !stream->eof) break;
+            l += nblk;
+        }
+        if (l > nline) l = nline;
 
-                default:
-                    continue;  // Unknown observation type - no validFlag set
-            }
+        if (l == 0) {
+            if (stream->eof || stream->idle) return 1; // End of (appended) data
+            stream->pos = 0;                           // Epoch block exceeds chunk
+            continue;
         }
 
-        // Add observation to the observation structure if valid
-        if (validFlag) {
-            if (!AddObs(obs, &newObs)) {
-                break;  // Failed to add observation, stop processing but keep existing data
-            }
+        // Parse complete epoch blocks
+        buffer_t view = *buffer;
+        view.nline = l;
+        int ver = (int)rnxObs->header.ver;
+        int info = (ver == 2) ? ReadRnxObsBodyV2(&view, rnxObs, 0, stream->rcv, obs)
+                              : ReadRnxObsBodyV3(&view, rnxObs, 0, stream->rcv, obs);
+
+        // Keep remaining lines for next chunk
+        stream->pos = RnxObsStreamPos(stream, l);
+
+        if (!info) return 0;
+        if (obs->n > n0 || stream->idle || (stream->eof && stream->pos >= buffer->size)) {
+            return 1;
         }
     }
+}
+
+// Read next epoch of observation stream into stream->epoch
+// (1: epoch read, 0: end of (appended) data, -1: failure)
+static int ReadRnxObsStreamEpoch(rnxObsStream_t *stream)
+{
+    obss_t *chunk = &stream->obs;
+    obss_t *epoch = &stream->epoch;
+    epoch->n = 0;
+
+    // Parse next chunk if all observation data are used
+    if (stream->idx >= chunk->n) {
+        chunk->n = 0;
+        stream->idx = 0;
+        if (!ReadRnxObsStreamChunk(stream, chunk)) return -1;
+        if (chunk->n == 0) return 0;
+    }
+
+    // Copy observation data of the epoch (epochs do not cross chunks)
+    double time = chunk->obs[stream->idx].time;
+    for (; stream->idx < chunk->n && chunk->obs[stream->idx].time == time; stream->idx++) {
+        if (!AddObs(epoch, &chunk->obs[stream->idx])) return -1;
+    }
+
+    // Sort by satellite
+    SortObss(epoch);
 
     return 1;
 }
 
+// Wait for poll interval of followed file
+static void SleepRnxObs(double sec)
+{
+#ifdef _WIN32
+    Sleep((DWORD)(sec * 1E3));
+#else
+    struct timespec ts;
+    ts.tv_sec = (time_t)sec;
+    ts.tv_nsec = (long)((sec - (double)ts.tv_sec) * 1E9);
+    nanosleep(&ts, NULL);
+#endif
+}
+
+#ifndef _WIN32
+// Split observation body lines [start, nline) at epoch block boundaries
+// (return: number of slices, bound[k], bound[k+1]: lines of slice k)
+//
+// Slices hold about the same number of lines. Blocks are walked with the same
+// rule as the parsers, so the slices parse to the same data as one pass.
+static int SplitRnxObsBody(const buffer_t *buffer, const rnxObs_t *rnxObs, size_t start,
+                           size_t *bound, int nslice)
+{
+    size_t l = start, nline = buffer->nline;
+    int k = 0;
+    bound[0] = start;
+
+    for (int j = 1; j < nslice && l < nline; j++) {
+
+        // Walk epoch blocks up to the target line of slice j
+        size_t target = start + (nline - start) * j / nslice;
+        while (l < nline && l < target) {
+            int len = 0;
+            char *line = GetLine(buffer, l, &len);
+            size_t nblk = RnxObsBlockLen(rnxObs, line, len);
+            l += (nblk > 0) ? nblk : 1;
+        }
+        if (l < nline && l > bound[k]) bound[++k] = l;
+    }
+    bound[++k] = nline;
+
+    return k;
+}
+
+// Parse observation body slice (thread function)
+static void *ReadRnxObsSlice(void *arg)
+{
+    rnxObsSlice_t *slice = (rnxObsSlice_t*)arg;
+    int ver = (int)slice->rnxObs->header.ver;
+
+    slice->info = (ver == 2) ?
+        ReadRnxObsBodyV2(&slice->view, slice->rnxObs, slice->start, slice->rcv, &slice->obs) :
+        ReadRnxObsBodyV3(&slice->view, slice->rnxObs, slice->start, slice->rcv, &slice->obs);
+
+    return NULL;
+}
+#endif
+
 // Helper function to adjust time considering week handover
 static double AdjWeek(double t, double t0)
 {
@@ -1005,7 +1339,7 @@ static int ReadRnxNavHeader(const buffer_t *buffer, rnxNav_t *rnxNav)
         if (LineContains(line, len, "RINEX VERSION / TYPE", 60)) {
 
             // Set version and system
-            if (sscanf(line, "%lf", &ver) != 1) return 0;
+            if (!Str2Num(line, len, 0, 9, &ver)) return 0;
             rnxNav->header.ver = ver;
 
             if (ver < 3.0) {
@@ -1173,7 +1507,7 @@ static int ReadRnxNavBody(const buffer_t *buffer, rnxNav_t *rnxNav)
         } else { // v2
 
             // RINEX v2: Try to parse PRN from beginning
-            if (sscanf(line, "%d", &prn) == 1) {
+            if (Str2Int(line, len, 0, 2, &prn)) {
 
                 // Standard case: line starts with PRN number
                 sys = Str2Sys(rnxNav->header.sys);
@@ -1237,18 +1571,23 @@ static int ReadRnxNavBody(const buffer_t *buffer, rnxNav_t *rnxNav)
             int sys = Str2Sys(line[0]);
             if (sys == 0) continue;
 
-            if (sscanf(line, "%3s %4d %2d %2d %2d %2d %lf",
-                       body->satStr.str, &body->cal.year, &body->cal.mon, &body->cal.day,
-                       &body->cal.hour, &body->cal.min, &body->cal.sec) >= 7) {
+            // Epoch: A1,I2.2,1X,I4,5(1X,I2.2)
+            if (Str2Int(line, len,  4, 4, &body->cal.year) && Str2Int(line, len,  9, 2, &body->cal.mon) &&
+                Str2Int(line, len, 12, 2, &body->cal.day ) && Str2Int(line, len, 15, 2, &body->cal.hour) &&
+                Str2Int(line, len, 18, 2, &body->cal.min ) && Str2Num(line, len, 21, 2, &body->cal.sec)) {
+                strncpy(body->satStr.str, line, 3);
+                body->satStr.str[3] = '\0';
                 valid_epoch = 1;
             }
 
         } else { // v2
             // RINEX v2: Try to parse PRN from beginning
+            // Epoch: I2,5(1X,I2),F5.1
             int prn;
-            if (sscanf(line, "%d %2d %2d %2d %2d %2d %lf",
-                       &prn, &body->cal.year, &body->cal.mon, &body->cal.day,
-                       &body->cal.hour, &body->cal.min, &body->cal.sec) >= 7) {
+            if (Str2Int(line, len,  0, 2, &prn          ) && Str2Int(line, len,  2, 3, &body->cal.year) &&
+                Str2Int(line, len,  5, 3, &body->cal.mon) && Str2Int(line, len,  8, 3, &body->cal.day ) &&
+                Str2Int(line, len, 11, 3, &body->cal.hour) && Str2Int(line, len, 14, 3, &body->cal.min) &&
+                Str2Num(line, len, 17, 5, &body->cal.sec)) {
 
                 // Standard case: line starts with PRN number
                 if (body->cal.year < 80) body->cal.year += 2000; else body->cal.year += 1900;
@@ -1273,27 +1612,14 @@ static int ReadRnxNavBody(const buffer_t *buffer, rnxNav_t *rnxNav)
         // Check if epoch parsing was successful
         if (!valid_epoch) continue;
 
-        // Step 2: Parse clock parameters (handle D->E conversion)
-        char field[20];
+        // Step 2: Parse clock parameters (D19.12, D or E exponent)
         for (int i = 0; i < 3; i++) {
             int offset = (v3 ? 23 : 22) + i * 19;  // Clock field positions
             if (offset + 19 > len) {
                 body->clock[i] = 0.0;
                 continue;
             }
-
-            // Extract clock field
-            strncpy(field, line + offset, 19);
-            field[19] = '\0';
-
-            // Replace D or d with E for strtod
-            for (int k = 0; field[k] != '\0'; k++) {
-                if (field[k] == 'D' || field[k] == 'd') {
-                    field[k] = 'E';
-                }
-            }
-
-            body->clock[i] = strtod(field, NULL);
+            Str2Num(line, len, offset, 19, &body->clock[i]);
         }
 
         // Number of lines of orbit data
@@ -1316,7 +1642,6 @@ static int ReadRnxNavBody(const buffer_t *buffer, rnxNav_t *rnxNav)
             char *orbitline;
             if (!(orbitline = GetLine(buffer, l + 1 + i, &len))) break;
 
-            char field[20];
             for (int j = 0; j < 4; j++) {
                 int orbit_idx = i * 4 + j;
                 if (orbit_idx >= 28) break;
@@ -1327,18 +1652,8 @@ static int ReadRnxNavBody(const buffer_t *buffer, rnxNav_t *rnxNav)
                     continue;
                 }
 
-                // Parse orbit value
-                strncpy(field, orbitline + offset, 19);
-                field[19] = '\0';
-
-                // Replace D or d with E for strtod
-                for (int k = 0; field[k] != '\0'; k++) {
-                    if (field[k] == 'D' || field[k] == 'd') {
-                        field[k] = 'E';
-                    }
-                }
-
-                body->orbit[orbit_idx] = strtod(field, NULL);
+                // Parse orbit value (D19.12, D or E exponent)
+                Str2Num(orbitline, len, offset, 19, &body->orbit[orbit_idx]);
             }
         }
 
@@ -1575,6 +1890,18 @@ static int ArrangeNav(nav_t *nav, rnxNav_t *rnxNav)
     return 1;
 }
 
+// Length of file name without compression extension (.gz, .Z, .z)
+static int RnxNameLen(const char *filename)
+{
+    int len = (int)strlen(filename);
+
+    if (len > 3 && !strcmp(filename + len - 3, ".gz")) return len - 3;
+    if (len > 2 && (!strcmp(filename + len - 2, ".Z") || !strcmp(filename + len - 2, ".z"))) {
+        return len - 2;
+    }
+    return len;
+}
+
 // =============================================================================
 // RINEX check functions
 // =============================================================================
@@ -1584,11 +1911,14 @@ int IsRinexObs(const char *filename)
 {
     if (!filename) return 0;
 
-    int len = strlen(filename);
+    // Compressed files (.gz, .Z) are checked by the name without compression extension
+    int len = RnxNameLen(filename);
     if (len < 4) return 0;
 
-    // Check for .XXo or .XXO pattern (where XX is 2 digits, e.g., .02o, .22o, .25O)
-    if ((filename[len-1] == 'o' || filename[len-1] == 'O') && filename[len-4] == '.') {
+    // Check for .XXo/.XXO or compact RINEX .XXd/.XXD pattern (where XX is 2 digits,
+    // e.g., .02o, .22o, .25O, .25d)
+    if ((filename[len-1] == 'o' || filename[len-1] == 'O' ||
+         filename[len-1] == 'd' || filename[len-1] == 'D') && filename[len-4] == '.') {
         char c1 = filename[len-3];
         char c2 = filename[len-2];
         if (c1 >= '0' && c1 <= '9' && c2 >= '0' && c2 <= '9') {
@@ -1596,12 +1926,8 @@ int IsRinexObs(const char *filename)
         }
     }
 
-    // Check for .rnx pattern
-    if (len >= 4 &&
-        filename[len-1] == 'x' &&
-        filename[len-2] == 'n' &&
-        filename[len-3] == 'r' &&
-        filename[len-4] == '.') {
+    // Check for .rnx or compact RINEX .crx pattern
+    if (!strncmp(filename + len - 4, ".rnx", 4) || !strncmp(filename + len - 4, ".crx", 4)) {
         return 1;
     }
 
@@ -1613,7 +1939,8 @@ int IsRinexNav(const char *filename)
 {
     if (!filename) return 0;
 
-    int len = strlen(filename);
+    // Compressed files (.gz, .Z) are checked by the name without compression extension
+    int len = RnxNameLen(filename);
     if (len < 4) return 0;
 
     // Check for pattern (where XX is 2 digits, e.g., .02n, .22n, .25N)
@@ -1654,7 +1981,7 @@ int ReadRnxObs(nav_t *nav, obss_t *obs, int rcvidx, const char *filename)
     if (!nav || !obs || !filename) return 0;
 
     // Check if the receiver index is valid
-    if (rcvidx <= 0) return 0;
+    if (rcvidx <= 0 || rcvidx > NRCV) return 0;
 
     // Check file name is the RINEX obs file name
     if (!IsRinexObs(filename)) return 0;
@@ -1678,43 +2005,280 @@ int ReadRnxObs(nav_t *nav, obss_t *obs, int rcvidx, const char *filename)
 
     // Read RINEX observation header
     if (!ReadRnxObsHeader(&buffer, &rnxObs)) {
-        FreeRnxObs(&rnxObs);
         FreeBuff(&buffer);
         return 0;
     }
 
+    // Read filter of processing options
+    rnxObs.opt = nav->opt;
+
     // Check RINEX version
     int ver = (int)rnxObs.header.ver;
     if (ver < 2 || ver > 3) {
-        FreeRnxObs(&rnxObs);
         FreeBuff(&buffer);
         return 0;
     }
 
-    // Read RINEX observation body
-    if (!ReadRnxObsBody(&buffer, &rnxObs)) {
-        FreeRnxObs(&rnxObs);
+    // Read RINEX observation body into observation data (discard partial data on failure)
+    int n0 = obs->n;
+    int info = ReadRnxObsBody(&buffer, &rnxObs, rcvidx, obs);
+    if (!info) obs->n = n0;
+
+    // Copy station information to navigation data
+    if (info) nav->sta[rcvidx - 1] = rnxObs.header.sta;
+
+    // Free memory
+    FreeBuff(&buffer);
+
+    return info;
+}
+
+// Read RINEX observation file with parallel body parsing (support version 2.xx and 3.xx)
+int ReadRnxObsPar(nav_t *nav, obss_t *obs, int rcvidx, const char *filename, int nthread)
+{
+#ifdef _WIN32
+    nthread = 1; // No pthreads: serial read
+#endif
+    if (nthread <= 1) return ReadRnxObs(nav, obs, rcvidx, filename);
+
+#ifndef _WIN32
+    if (nthread > MAX_RNX_THREAD) nthread = MAX_RNX_THREAD;
+
+    // Check if the navigation, observation, and file name are valid
+    if (!nav || !obs || !filename) return 0;
+
+    // Check if the receiver index is valid
+    if (rcvidx <= 0 || rcvidx > NRCV) return 0;
+
+    // Check file name is the RINEX obs file name
+    if (!IsRinexObs(filename)) return 0;
+
+    // Initialize file buffer
+    buffer_t buffer;
+    if (!InitBuff(&buffer)) return 0;
+
+    // Get file buffer
+    if (!GetBuff(filename, &buffer)) {
         FreeBuff(&buffer);
         return 0;
     }
 
-    // Copy station information to navigation data
-    if (rcvidx <= NRCV) {
-        nav->sta[rcvidx - 1] = rnxObs.header.sta;
+    // Initialize RINEX observation structure
+    rnxObs_t rnxObs;
+    if (!InitRnxObs(&rnxObs)) {
+        FreeBuff(&buffer);
+        return 0;
     }
 
-    // Add and arrange observation data to observation structure
-    if (!ArrangeObs(obs, &rnxObs, rcvidx)) {
-        FreeRnxObs(&rnxObs);
+    // Read RINEX observation header
+    if (!ReadRnxObsHeader(&buffer, &rnxObs)) {
         FreeBuff(&buffer);
         return 0;
     }
 
+    // Read filter of processing options
+    rnxObs.opt = nav->opt;
+
+    // Check RINEX version
+    int ver = (int)rnxObs.header.ver;
+    if (ver < 2 || ver > 3) {
+        FreeBuff(&buffer);
+        return 0;
+    }
+
+    // Split body at epoch block boundaries
+    size_t bound[MAX_RNX_THREAD + 1];
+    int nslice = SplitRnxObsBody(&buffer, &rnxObs, RnxObsBodyStart(&buffer), bound, nthread);
+
+    rnxObsSlice_t slice[MAX_RNX_THREAD];
+    pthread_t     thread[MAX_RNX_THREAD];
+    int           created[MAX_RNX_THREAD];
+
+    for (int k = 0; k < nslice; k++) {
+        slice[k].view       = buffer;
+        slice[k].view.nline = bound[k + 1];
+        slice[k].rnxObs     = &rnxObs;
+        slice[k].start      = bound[k];
+        slice[k].rcv        = rcvidx;
+        slice[k].info       = 0;
+        InitObss(&slice[k].obs);
+    }
+
+    // Parse slices (first slice on calling thread, serial if thread creation fails)
+    for (int k = 1; k < nslice; k++) {
+        created[k] = !pthread_create(&thread[k], NULL, ReadRnxObsSlice, &slice[k]);
+    }
+    ReadRnxObsSlice(&slice[0]);
+
+    for (int k = 1; k < nslice; k++) {
+        if (created[k]) pthread_join(thread[k], NULL);
+        else ReadRnxObsSlice(&slice[k]);
+    }
+
+    // Concatenate slices in file order (discard partial data on failure)
+    int n0 = obs->n, info = 1, nadd = 0;
+    for (int k = 0; k < nslice; k++) nadd += slice[k].obs.n;
+    if (!ReserveObss(obs, n0 + nadd)) info = 0;
+
+    for (int k = 0; k < nslice; k++) {
+        if (!slice[k].info) info = 0;
+        for (int i = 0; i < slice[k].obs.n && info; i++) {
+            if (!AddObs(obs, &slice[k].obs.obs[i])) info = 0;
+        }
+        FreeObss(&slice[k].obs);
+    }
+    if (!info) obs->n = n0;
+
+    // Copy station information to navigation data
+    if (info) nav->sta[rcvidx - 1] = rnxObs.header.sta;
+
     // Free memory
-    FreeRnxObs(&rnxObs);
     FreeBuff(&buffer);
 
-    return 1; // Success
+    return info;
+#endif
+}
+
+// Read RINEX observation file in chunks (support version 2.xx and 3.xx)
+int ReadRnxObsStream(nav_t *nav, obss_t *obs, int rcvidx, const char *filename,
+                     rnxObsFunc_t func, void *data)
+{
+    // Check if the parameters are valid
+    if (!nav || (!obs && !func) || !filename) return 0;
+
+    // Check if the receiver index is valid
+    if (rcvidx <= 0 || rcvidx > NRCV) return 0;
+
+    // Check file name is the RINEX obs file name
+    if (!IsRinexObs(filename)) return 0;
+
+    // Open stream and read header
+    rnxObsStream_t stream;
+    if (!OpenRnxObsStream(&stream, filename, 0)) {
+        FreeRnxObsStream(&stream);
+        return 0;
+    }
+    stream.rcv = rcvidx;
+    stream.rnxObs.opt = nav->opt;
+
+    // Copy station information to navigation data
+    nav->sta[rcvidx - 1] = stream.rnxObs.header.sta;
+
+    // Parse chunks until end of file (directly into obs without func)
+    obss_t *chunk = func ? &stream.obs : obs;
+    int info = 1;
+
+    while (info) {
+        int n0 = chunk->n;
+        if (!(info = ReadRnxObsStreamChunk(&stream, chunk)) || chunk->n == n0) break;
+        if (!func) continue;
+
+        // Pass observation data of chunk to func
+        for (int i = 0; i < chunk->n && info; i++) info = func(&chunk->obs[i], data);
+        chunk->n = 0;
+    }
+
+    FreeRnxObsStream(&stream);
+
+    return info;
+}
+
+// Open RINEX observation file for epoch-by-epoch reading (support version 2.xx and 3.xx)
+rnxObsStream_t *OpenRnxObs(nav_t *nav, int rcvidx, const char *filename)
+{
+    // Check if the parameters are valid
+    if (!nav || !filename) return NULL;
+
+    // Check if the receiver index is valid
+    if (rcvidx <= 0 || rcvidx > NRCV) return NULL;
+
+    // Check file name is the RINEX obs file name
+    if (!IsRinexObs(filename)) return NULL;
+
+    // Allocate stream
+    rnxObsStream_t *stream = (rnxObsStream_t*)malloc(sizeof(rnxObsStream_t));
+    if (!stream) return NULL;
+
+    // Open stream and read header
+    if (!OpenRnxObsStream(stream, filename, 0)) {
+        FreeRnxObsStream(stream);
+        free(stream);
+        return NULL;
+    }
+    stream->rcv = rcvidx;
+    stream->rnxObs.opt = nav->opt;
+
+    // Copy station information to navigation data
+    nav->sta[rcvidx - 1] = stream->rnxObs.header.sta;
+
+    return stream;
+}
+
+// Read next epoch of RINEX observation file
+const obss_t *NextRnxObs(rnxObsStream_t *stream)
+{
+    if (!stream) return NULL;
+
+    return (ReadRnxObsStreamEpoch(stream) > 0) ? &stream->epoch : NULL;
+}
+
+// Close RINEX observation file
+void CloseRnxObs(rnxObsStream_t *stream)
+{
+    if (!stream) return;
+
+    FreeRnxObsStream(stream);
+    free(stream);
+}
+
+// Follow growing RINEX observation file (support version 2.xx and 3.xx)
+int FollowRnxObs(nav_t *nav, int rcvidx, const char *filename, rnxEpochFunc_t func,
+                 void *data, double interval, double timeout)
+{
+    // Check if the parameters are valid
+    if (!nav || !filename || !func) return 0;
+
+    // Check if the receiver index is valid
+    if (rcvidx <= 0 || rcvidx > NRCV) return 0;
+
+    // Check file name is the RINEX obs file name
+    if (!IsRinexObs(filename)) return 0;
+
+    // Open stream in follow mode and read header
+    rnxObsStream_t stream;
+    if (!OpenRnxObsStream(&stream, filename, 1)) {
+        FreeRnxObsStream(&stream);
+        return 0;
+    }
+    stream.rcv = rcvidx;
+    stream.rnxObs.opt = nav->opt;
+
+    // Copy station information to navigation data
+    nav->sta[rcvidx - 1] = stream.rnxObs.header.sta;
+
+    // Pass completed epochs to func, poll the file while no epoch is appended
+    if (interval < RNX_POLL_MIN) interval = RNX_POLL_MIN;
+    double wait = 0.0;
+    int info = 0;
+
+    while (!info) {
+        int stat = ReadRnxObsStreamEpoch(&stream);
+
+        if (stat < 0) break;                                  // Read failure
+        else if (stat > 0) {
+            wait = 0.0;
+            if (!func(&stream.epoch, data)) info = 1;         // Stopped by func
+        }
+        else if (timeout > 0.0 && wait >= timeout) info = 2;  // No data appended
+        else {
+            SleepRnxObs(interval);
+            wait += interval;
+        }
+    }
+
+    FreeRnxObsStream(&stream);
+
+    return info;
 }
 
 // Read RINEX navigation file (support version 2.xx and 3.xx)
@@ -69,6 +69,23 @@ int AddSig(sigs_t *sigs, const sig_t *sig) {
     return 1;
 }
 
+// -----------------------------------------------------------------------------
+// Reserve memory of signal data set (at least n signals, not shrunk)
+// -----------------------------------------------------------------------------
+int ReserveSigs(sigs_t *sigs, int n) {
+    if (!sigs || n < 0) return 0;
+
+    if (n <= sigs->nmax) return 1;
+
+    sig_t *newsig = (sig_t *)realloc(sigs->sig, n * sizeof(sig_t));
+    if (!newsig) return 0;
+
+    sigs->sig = newsig;
+    sigs->nmax = n;
+
+    return 1;
+}
+
 // -----------------------------------------------------------------------------
 // Sort signals by time, receiver, satellite
 // -----------------------------------------------------------------------------